@@ -0,0 +1,245 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Heap layout and allocator control for the pointer-based designs. A freshly started benchmark
+// allocates its objects back to back, which is far kinder to the caches and TLB than the long-lived, fragmented
+// heap of a production book. Designs allocate through makeInstrument() so the driver can scatter
+// those allocations:
+//   Interleave - a junk block of random size is allocated (and kept) before every instrument.
+//   Churn      - before the first instrument, a junk heap of one block per instrument (capped at
+//                CHURN_BUDGET_BYTES) is allocated and a random half of it freed, so instruments land
+//                in holes spread across the heap.
+//
+// Independently, the instruments themselves can come from one of three backends:
+//   Malloc - one new per instrument, the original behaviour.
+//   Arena  - a single std::pmr::monotonic_buffer_resource; instruments are packed in load order.
+//   Pool   - one monotonic resource per concrete type, so all StockData are contiguous, as are all
+//            OptionData.
+// Arena and pool memory is released in bulk when the driver moves on to the next book; the deleter
+// only runs destructors for instruments allocated there, which it recognises by address.
+
+enum class ScatterMode { None, Interleave, Churn };
+
+inline const char* scatterModeName(ScatterMode mode) {
+    switch (mode) {
+    case ScatterMode::Interleave: return "interleave";
+    case ScatterMode::Churn: return "churn";
+    default: return "none";
+    }
+}
+
+inline bool parseScatterMode(const std::string& name, ScatterMode& mode) {
+    for (ScatterMode candidate : {ScatterMode::None, ScatterMode::Interleave, ScatterMode::Churn}) {
+        if (name == scatterModeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+class HeapScatter {
+public:
+    static constexpr size_t MIN_JUNK_BYTES = 16;
+    static constexpr size_t MAX_JUNK_BYTES = 256;
+    // Bounds the churn junk so --sweep sizes stay runnable: at 100M instruments one block each would
+    // be ~14 GB. Past the budget, the remaining instruments are allocated after the churned region.
+    static constexpr size_t CHURN_BUDGET_BYTES = size_t{512} << 20;
+
+    // Releases the junk of the previous book and arms the scatter for the next one.
+    void reset(ScatterMode newMode, size_t newBookSize, uint64_t seed) {
+        junk.clear();
+        junk.shrink_to_fit();
+        mode = newMode;
+        bookSize = newBookSize;
+        rng.seed(seed);
+        churned = false;
+    }
+
+    void beforeAllocation() {
+        if (mode == ScatterMode::Interleave) {
+            junk.push_back(allocateJunk());
+        } else if (mode == ScatterMode::Churn && !churned) {
+            churned = true;
+            size_t blocks = std::min(bookSize, CHURN_BUDGET_BYTES / (MIN_JUNK_BYTES + MAX_JUNK_BYTES) * 2);
+            junk.reserve(blocks);
+            for (size_t i = 0; i < blocks; ++i) junk.push_back(allocateJunk());
+            for (auto& block : junk) {
+                if (rng() % 2 == 0) block.reset();
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<char[]> allocateJunk() {
+        size_t bytes = MIN_JUNK_BYTES + rng() % (MAX_JUNK_BYTES - MIN_JUNK_BYTES);
+        return std::make_unique<char[]>(bytes);
+    }
+
+    ScatterMode mode = ScatterMode::None;
+    size_t bookSize = 0;
+    bool churned = false;
+    std::mt19937_64 rng;
+    std::vector<std::unique_ptr<char[]>> junk;
+};
+
+inline HeapScatter& heapScatter() {
+    static HeapScatter scatter;
+    return scatter;
+}
+
+enum class AllocatorMode { Malloc, Arena, Pool };
+
+inline const char* allocatorModeName(AllocatorMode mode) {
+    switch (mode) {
+    case AllocatorMode::Arena: return "arena";
+    case AllocatorMode::Pool: return "pool";
+    default: return "malloc";
+    }
+}
+
+inline bool parseAllocatorMode(const std::string& name, AllocatorMode& mode) {
+    for (AllocatorMode candidate : {AllocatorMode::Malloc, AllocatorMode::Arena, AllocatorMode::Pool}) {
+        if (name == allocatorModeName(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Upstream of the arena and pools: hands out their chunks and remembers the address ranges, so
+// the deleter can tell resource memory from malloc'd instruments without storing a flag.
+class ChunkTracker : public std::pmr::memory_resource {
+public:
+    bool owns(const void* p) const {
+        auto address = reinterpret_cast<uintptr_t>(p);
+        auto chunk = chunks.upper_bound(address);
+        if (chunk == chunks.begin()) return false;
+        --chunk;
+        return address < chunk->second;
+    }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        auto address = reinterpret_cast<uintptr_t>(p);
+        chunks[address] = address + bytes;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        chunks.erase(reinterpret_cast<uintptr_t>(p));
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::map<uintptr_t, uintptr_t> chunks;  // begin -> end
+};
+
+class InstrumentAllocator {
+public:
+    static constexpr size_t ARENA_BYTES_PER_INSTRUMENT = 32;
+
+    // Frees every arena in one go. Should instruments of the previous book still be alive, their
+    // resources are retired instead and freed at the first reset after the last of them is gone.
+    void reset(AllocatorMode newMode, size_t bookSize) {
+        for (auto& [type, pool] : pools) retired.push_back(std::move(pool));
+        if (arena) retired.push_back(std::move(arena));
+        if (liveInstruments == 0) retired.clear();
+        pools.clear();
+        ++generation;
+        mode = newMode;
+        initialBytes = std::max<size_t>(bookSize * ARENA_BYTES_PER_INSTRUMENT, 4096);
+        if (mode == AllocatorMode::Arena) {
+            arena = std::make_unique<std::pmr::monotonic_buffer_resource>(initialBytes, &tracker);
+        }
+    }
+
+    AllocatorMode mode = AllocatorMode::Malloc;
+
+    // The arena, or T's pool. Cached per type until the next reset, so pool mode pays the map
+    // lookup once per book rather than once per instrument.
+    template <typename T>
+    std::pmr::memory_resource& resource() {
+        static uint64_t cachedGeneration = 0;
+        static std::pmr::memory_resource* cached = nullptr;
+        if (cachedGeneration != generation) {
+            cached = &resourceFor(typeid(T));
+            cachedGeneration = generation;
+        }
+        return *cached;
+    }
+
+    // Instruments currently alive in arena or pool memory.
+    size_t liveInstruments = 0;
+
+    bool owns(const void* p) const { return liveInstruments > 0 && tracker.owns(p); }
+
+private:
+    std::pmr::memory_resource& resourceFor(std::type_index type) {
+        if (mode == AllocatorMode::Arena) return *arena;
+        auto& pool = pools[type];
+        if (!pool) pool = std::make_unique<std::pmr::monotonic_buffer_resource>(initialBytes, &tracker);
+        return *pool;
+    }
+
+    uint64_t generation = 1;
+    size_t initialBytes = 0;
+    ChunkTracker tracker;  // declared before the resources, so it outlives them
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    std::unordered_map<std::type_index, std::unique_ptr<std::pmr::monotonic_buffer_resource>> pools;
+    std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> retired;
+};
+
+inline InstrumentAllocator& instrumentAllocator() {
+    static InstrumentAllocator allocator;
+    return allocator;
+}
+
+// Stateless, so InstrumentPtr stays one word like std::unique_ptr and the pointer-based books keep
+// their layout. Instruments in arena or pool memory only have their destructor run.
+struct InstrumentDeleter {
+    template <typename T>
+    void operator()(T* p) const {
+        auto& allocator = instrumentAllocator();
+        if (allocator.owns(p)) {
+            p->~T();
+            --allocator.liveInstruments;
+        } else {
+            delete p;
+        }
+    }
+};
+
+template <typename T>
+using InstrumentPtr = std::unique_ptr<T, InstrumentDeleter>;
+
+static_assert(sizeof(InstrumentPtr<std::string>) == sizeof(void*), "InstrumentPtr must stay a plain pointer");
+
+// std::make_unique for book instruments, honouring the configured allocator and heap scatter.
+template <typename T, typename... Args>
+InstrumentPtr<T> makeInstrument(Args&&... args) {
+    heapScatter().beforeAllocation();
+    auto& allocator = instrumentAllocator();
+    if (allocator.mode == AllocatorMode::Malloc) {
+        return InstrumentPtr<T>(new T(std::forward<Args>(args)...));
+    }
+    void* memory = allocator.resource<T>().allocate(sizeof(T), alignof(T));
+    InstrumentPtr<T> instrument(new (memory) T(std::forward<Args>(args)...));
+    ++allocator.liveInstruments;
+    return instrument;
+}
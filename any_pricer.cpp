@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
+
+struct StockData {
+    double priceFactor = 1.2;
+    double commonFactor = 0.5;
+};
+
+struct OptionData {
+    double volatility = 0.8;
+    double commonFactor = 0.5;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class Pricer {
+public:
+    double calculatePrice(const StockData& data) const { return data.priceFactor * 1.1 + data.commonFactor; }
+    double calculatePrice(const OptionData& data) const { return optionPrice(data.volatility, data.commonFactor, data.contract); }
+};
+
+template <typename T>
+concept PricedBy = std::is_nothrow_move_constructible_v<T> && requires(const T& data, const Pricer& pricer) {
+    { pricer.calculatePrice(data) } -> std::convertible_to<double>;
+};
+
+// Hand-rolled type erasure for anything Pricer can price. The data lives inline in a fixed buffer
+// (a larger type fails to compile rather than silently falling back to the heap), the price entry
+// sits inline next to it so a call is one indirect jump, and copy/move/destroy go through a
+// per-type table of function pointers built at compile time.
+class AnyPricer {
+public:
+    // Sized for this design's instruments: two doubles, plus the contract in the Black-Scholes build.
+    static constexpr size_t BUFFER_SIZE = std::max(sizeof(StockData), sizeof(OptionData));
+
+    template <typename T>
+        requires(!std::same_as<T, AnyPricer> && PricedBy<T>)
+    explicit AnyPricer(T data) : price(&priceAs<T>), lifecycle(&LIFECYCLE<T>) {
+        static_assert(sizeof(T) <= BUFFER_SIZE && alignof(T) <= alignof(std::max_align_t),
+                      "data does not fit AnyPricer's inline buffer");
+        ::new (buffer) T(std::move(data));
+    }
+
+    AnyPricer(const AnyPricer& other) : price(other.price), lifecycle(other.lifecycle) {
+        lifecycle->copy(buffer, other.buffer);
+    }
+    AnyPricer(AnyPricer&& other) noexcept : price(other.price), lifecycle(other.lifecycle) {
+        lifecycle->move(buffer, other.buffer);
+    }
+    AnyPricer& operator=(AnyPricer other) noexcept {
+        lifecycle->destroy(buffer);
+        price = other.price;
+        lifecycle = other.lifecycle;
+        lifecycle->move(buffer, other.buffer);
+        return *this;
+    }
+    ~AnyPricer() { lifecycle->destroy(buffer); }
+
+    double calculatePrice(const Pricer& pricer) const { return price(buffer, pricer); }
+
+private:
+    struct Lifecycle {
+        void (*copy)(std::byte* to, const std::byte* from);
+        void (*move)(std::byte* to, std::byte* from);
+        void (*destroy)(std::byte* data);
+    };
+
+    template <typename T>
+    static double priceAs(const std::byte* data, const Pricer& pricer) {
+        return pricer.calculatePrice(*as<T>(data));
+    }
+
+    template <typename T>
+    static T* as(std::byte* data) { return std::launder(reinterpret_cast<T*>(data)); }
+    template <typename T>
+    static const T* as(const std::byte* data) { return std::launder(reinterpret_cast<const T*>(data)); }
+
+    template <typename T>
+    static constexpr Lifecycle LIFECYCLE = {
+        [](std::byte* to, const std::byte* from) { ::new (to) T(*as<T>(from)); },
+        [](std::byte* to, std::byte* from) { ::new (to) T(std::move(*as<T>(from))); },
+        [](std::byte* data) { as<T>(data)->~T(); },
+    };
+
+    alignas(std::max_align_t) std::byte buffer[BUFFER_SIZE];
+    double (*price)(const std::byte* data, const Pricer& pricer);
+    const Lifecycle* lifecycle;
+};
+
+SPEEDFP_DESIGN(any_pricer) {
+    Pricer pricer;
+    std::vector<AnyPricer> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData{});
+        } else {
+            dataSamples.emplace_back(OptionData{.contract = optionContract(options++)});
+        }
+    }
+
+    benchmark("Design: SBO AnyPricer with Pricer", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(data.calculatePrice(pricer));
+        }
+    }, ITERATIONS);
+
+    benchmarkScaling("Design: SBO AnyPricer with Pricer", dataSamples, [&](const auto& data) {
+        return data.calculatePrice(pricer);
+    });
+}
+
+} // namespace
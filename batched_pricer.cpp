@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <span>
+
+#include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
+
+class Pricer;
+
+class Data {
+public:
+    explicit Data(const Pricer* p) : pricer(p) {}
+    virtual ~Data() = default;
+    virtual double getCommonFactor() const { return commonFactor; }
+    double calculatePriceImpl() const;
+    const Pricer* getPricer() const { return pricer; }
+protected:
+    double commonFactor = 0.5;
+    const Pricer* pricer;
+};
+
+// The plug-in interface keeps its per-instrument entry point and gains a batch one: a pricer is
+// handed a span of its own instruments and fills one price per instrument, so the indirect call is
+// paid once per span and the loop inside it is ordinary, inlinable code.
+class Pricer {
+public:
+    virtual ~Pricer() = default;
+    virtual double calculatePrice(const Data* data) const = 0;
+    virtual void calculatePrices(std::span<const Data* const> data, std::span<double> prices) const = 0;
+};
+
+class StockData final : public Data {
+public:
+    explicit StockData(const Pricer* p) : Data(p), priceFactor(1.2) {}
+    double getCommonFactor() const override { return commonFactor; }
+    double priceFactor;
+};
+
+class OptionData final : public Data {
+public:
+    OptionData(const Pricer* p, const OptionContract& terms) : Data(p), volatility(0.8), contract(terms) {}
+    double getCommonFactor() const override { return commonFactor; }
+    double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+// A pricer only ever receives its own instruments, so the downcast is static and, with the data
+// classes final, getCommonFactor() is called directly.
+class StockPricer final : public Pricer {
+public:
+    double calculatePrice(const Data* data) const override { return price(static_cast<const StockData*>(data)); }
+    void calculatePrices(std::span<const Data* const> data, std::span<double> prices) const override {
+        for (size_t i = 0; i < data.size(); ++i) prices[i] = price(static_cast<const StockData*>(data[i]));
+    }
+private:
+    static double price(const StockData* stock) { return stock->priceFactor * 1.1 + stock->getCommonFactor(); }
+};
+
+class OptionPricer final : public Pricer {
+public:
+    double calculatePrice(const Data* data) const override { return price(static_cast<const OptionData*>(data)); }
+    void calculatePrices(std::span<const Data* const> data, std::span<double> prices) const override {
+        for (size_t i = 0; i < data.size(); ++i) prices[i] = price(static_cast<const OptionData*>(data[i]));
+    }
+private:
+    static double price(const OptionData* option) { return optionPrice(option->volatility, option->getCommonFactor(), option->contract); }
+};
+
+double Data::calculatePriceImpl() const { return pricer->calculatePrice(this); }
+
+// Instruments grouped by the pricer they name, each group in book order. Every member keeps its
+// position in the book, so prices come back in book order whatever the grouping.
+class PricerBook {
+public:
+    void add(const Data* data) {
+        auto group = std::find_if(groups.begin(), groups.end(),
+                                  [&](const Group& g) { return g.pricer == data->getPricer(); });
+        if (group == groups.end()) group = groups.insert(groups.end(), Group{data->getPricer(), {}, {}});
+        group->members.push_back(data);
+        group->positions.push_back(count++);
+    }
+
+    size_t size() const { return count; }
+
+    // Fills prices (size() entries, in book order) with one calculatePrices call per batchSize
+    // instruments of a group, scattering each batch back to the members' book positions.
+    void price(size_t batchSize, std::span<double> prices) {
+        batchPrices.resize(batchSize);
+        for (const Group& group : groups) {
+            std::span<const Data* const> members(group.members);
+            for (size_t start = 0; start < members.size(); start += batchSize) {
+                size_t n = std::min(batchSize, members.size() - start);
+                group.pricer->calculatePrices(members.subspan(start, n), std::span(batchPrices).first(n));
+                for (size_t i = 0; i < n; ++i) prices[group.positions[start + i]] = batchPrices[i];
+            }
+        }
+    }
+
+    // The same walk and scatter with one calculatePrice call per instrument.
+    void priceEach(std::span<double> prices) const {
+        for (const Group& group : groups) {
+            for (size_t i = 0; i < group.members.size(); ++i) {
+                prices[group.positions[i]] = group.pricer->calculatePrice(group.members[i]);
+            }
+        }
+    }
+
+private:
+    struct Group {
+        const Pricer* pricer;
+        std::vector<const Data*> members;
+        std::vector<size_t> positions;
+    };
+
+    std::vector<Group> groups;
+    std::vector<double> batchPrices;
+    size_t count = 0;
+};
+
+constexpr size_t BATCH_SIZES[] = {1, 4, 16, 64, 256, 1024, 4096};
+
+SPEEDFP_DESIGN(batched_pricer) {
+    StockPricer stockPricer;
+    OptionPricer optionPricer;
+
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    PricerBook book;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, optionContract(options++)));
+        }
+        book.add(dataSamples.back().get());
+    }
+
+    // Reference: per-instrument calls in book order, which pays for the type mix the groups remove.
+    std::vector<double> expected(book.size());
+    benchmark("Design: Batched Pricer, per-instrument calls in book order", [&]() {
+        for (size_t i = 0; i < dataSamples.size(); ++i) {
+            expected[i] = dataSamples[i]->calculatePriceImpl();
+        }
+        clobberMemory();
+    }, ITERATIONS);
+
+    // The batches are compared against per-instrument calls over the same groups and scatter, so
+    // the only difference is how many instruments each indirect call covers.
+    std::vector<double> prices(book.size());
+    benchmark("Design: Batched Pricer, per-instrument calls by pricer group", [&]() {
+        book.priceEach(prices);
+        clobberMemory();
+    }, ITERATIONS);
+
+    for (size_t batchSize : BATCH_SIZES) {
+        benchmark("Design: Batched Pricer, batches of " + std::to_string(batchSize) + " by pricer group", [&]() {
+            book.price(batchSize, prices);
+            clobberMemory();
+        }, ITERATIONS);
+        if (prices != expected) {
+            std::cerr << "    batches of " << batchSize << " do not reproduce the book-order prices\n";
+        }
+    }
+}
+
+} // namespace
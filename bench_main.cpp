@@ -0,0 +1,256 @@
+#include "benchmark.h"
+#include "results_store.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter=REGEX       run only designs whose name matches\n"
+              << "  --repetitions=N      run every design N times (default 1)\n"
+              << "  --format=text|json|csv\n"
+              << "  --mix=LIST           comma-separated type mixes: alternating, shuffled, skewed, bursty,\n"
+              << "                       replay or all (default: all but replay)\n"
+              << "  --mix-file=PATH      replay instrument types from a file of 'S'/'O' characters\n"
+              << "  --seed=N             seed for the generated type mixes (default 42)\n"
+              << "  --sizes=LIST         comma-separated book sizes, K/M suffixes allowed (default 10K)\n"
+              << "  --sweep              book sizes 1K, 10K, 100K, 1M, 10M and 100M\n"
+              << "  --scatter=MODE       none, interleave or churn heap allocations of pointer-based books\n"
+              << "  --alloc=LIST         comma-separated instrument allocators: malloc, arena, pool or all\n"
+              << "                       (default malloc)\n"
+              << "  --threads=LIST       also price every book on a pinned work-stealing pool with each\n"
+              << "                       thread count, and run the pricing service with that many workers;\n"
+              << "                       'max' doubles from 1 up to all cores\n"
+              << "  --no-pin             do not pin pool workers to cores\n"
+              << "  --packed-output      pack per-chunk totals instead of one per cache line\n"
+              << "  --tick-rates=LIST    tick pipeline input rates in ticks/s, K/M suffixes allowed, 'max'\n"
+              << "                       for unthrottled (default 100K,1M,max)\n"
+              << "  --tick-file=PATH     replay a binary tick file through the tick pipeline\n"
+              << "  --service-rates=LIST pricing service request rates in requests/s, K/M suffixes allowed,\n"
+              << "                       'max' to saturate it (default 100K,1M,max)\n"
+              << "  --save=DIR           store the run with its samples as DIR/<commit>_<compiler>_<cpu>_<flags>.json\n"
+              << "  --baseline=FILE      compare the run against a stored one and exit 1 on a regression\n"
+              << "                       (needs --repetitions=5 or more on both runs)\n"
+              << "  --threshold=PCT      slowdown that counts as a regression (default 5)\n"
+              << "  --perf               capture hardware counters (Linux only)\n"
+              << "  --list               list registered designs and exit\n";
+}
+
+bool parseArguments(int argc, char** argv, BenchmarkOptions& options, bool& list) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* prefix) -> const char* {
+            size_t length = std::char_traits<char>::length(prefix);
+            return arg.compare(0, length, prefix) == 0 ? argv[i] + length : nullptr;
+        };
+
+        if (const char* v = value("--filter=")) {
+            options.filter = v;
+        } else if (const char* v = value("--repetitions=")) {
+            options.repetitions = std::max(1, std::atoi(v));
+        } else if (const char* v = value("--format=")) {
+            std::string format = v;
+            if (format == "text") options.format = OutputFormat::Text;
+            else if (format == "json") options.format = OutputFormat::Json;
+            else if (format == "csv") options.format = OutputFormat::Csv;
+            else return false;
+        } else if (const char* v = value("--mix=")) {
+            options.mixes.clear();
+            std::stringstream names(v);
+            for (std::string name; std::getline(names, name, ',');) {
+                TypeMix mix;
+                if (name == "all") {
+                    options.mixes = {TypeMix::Alternating, TypeMix::Shuffled, TypeMix::Skewed, TypeMix::Bursty};
+                } else if (parseTypeMix(name, mix)) {
+                    options.mixes.push_back(mix);
+                } else {
+                    return false;
+                }
+            }
+        } else if (const char* v = value("--mix-file=")) {
+            if (!loadTypeSequence(v, options.replay)) {
+                std::cerr << "Cannot read instrument types from " << v << "\n";
+                return false;
+            }
+        } else if (const char* v = value("--seed=")) {
+            options.seed = std::strtoull(v, nullptr, 10);
+        } else if (const char* v = value("--sizes=")) {
+            options.sizes.clear();
+            std::stringstream sizes(v);
+            for (std::string size; std::getline(sizes, size, ',');) {
+                size_t parsed = parseSize(size);
+                if (parsed == 0) return false;
+                options.sizes.push_back(parsed);
+            }
+        } else if (arg == "--sweep") {
+            options.sizes = SWEEP_SIZES;
+        } else if (const char* v = value("--scatter=")) {
+            if (!parseScatterMode(v, options.scatter)) return false;
+        } else if (const char* v = value("--alloc=")) {
+            options.allocators.clear();
+            std::stringstream names(v);
+            for (std::string name; std::getline(names, name, ',');) {
+                AllocatorMode mode;
+                if (name == "all") {
+                    options.allocators = {AllocatorMode::Malloc, AllocatorMode::Arena, AllocatorMode::Pool};
+                } else if (parseAllocatorMode(name, mode)) {
+                    options.allocators.push_back(mode);
+                } else {
+                    return false;
+                }
+            }
+        } else if (const char* v = value("--threads=")) {
+            options.threads.clear();
+            if (std::string(v) == "max") {
+                size_t cores = std::max(1u, std::thread::hardware_concurrency());
+                for (size_t threads = 1; threads < cores; threads *= 2) options.threads.push_back(threads);
+                options.threads.push_back(cores);
+                continue;
+            }
+            std::stringstream counts(v);
+            for (std::string count; std::getline(counts, count, ',');) {
+                size_t threads = parseSize(count);
+                if (threads == 0) return false;
+                options.threads.push_back(threads);
+            }
+        } else if (arg == "--no-pin") {
+            options.pinThreads = false;
+        } else if (arg == "--packed-output") {
+            options.packedOutput = true;
+        } else if (const char* v = value("--tick-rates=")) {
+            options.tickRates.clear();
+            std::stringstream rates(v);
+            for (std::string rate; std::getline(rates, rate, ',');) {
+                size_t parsed = rate == "max" ? 0 : parseSize(rate);
+                if (parsed == 0 && rate != "max") return false;
+                options.tickRates.push_back(parsed);
+            }
+        } else if (const char* v = value("--service-rates=")) {
+            options.serviceRates.clear();
+            std::stringstream rates(v);
+            for (std::string rate; std::getline(rates, rate, ',');) {
+                size_t parsed = rate == "max" ? 0 : parseSize(rate);
+                if (parsed == 0 && rate != "max") return false;
+                options.serviceRates.push_back(parsed);
+            }
+        } else if (const char* v = value("--tick-file=")) {
+            options.tickFile = v;
+        } else if (const char* v = value("--save=")) {
+            options.saveDir = v;
+        } else if (const char* v = value("--baseline=")) {
+            options.baseline = v;
+        } else if (const char* v = value("--threshold=")) {
+            if (!parseThreshold(v, options.regressionThreshold)) return false;
+        } else if (arg == "--perf") {
+            options.perfCounters = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            return false;
+        }
+    }
+
+    bool replayRequested = std::find(options.mixes.begin(), options.mixes.end(), TypeMix::Replay) != options.mixes.end();
+    if (!options.replay.empty() && !replayRequested) options.mixes.push_back(TypeMix::Replay);
+    if (options.replay.empty() && replayRequested) {
+        std::cerr << "--mix=replay needs --mix-file\n";
+        return false;
+    }
+    return true;
+}
+
+std::string csvEscape(const std::string& text) {
+    if (text.find_first_of(",\"") == std::string::npos) return text;
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"') escaped += '"';
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void writeCsv(const std::vector<BenchmarkResult>& results) {
+    std::cout << "design,workload,book_size,scatter,allocator,label,repetition,median_ns,min_ns,p90_ns,p99_ns,mean_ns,ci95_ns,stddev_ns,noisy,counters\n";
+    for (const auto& r : results) {
+        std::cout << csvEscape(r.design) << "," << r.workload << "," << r.bookSize << "," << r.scatter << "," << r.allocator << ","
+                  << csvEscape(r.label) << "," << r.repetition << "," << r.median << ","
+                  << r.min << "," << r.p90 << ",";
+        if (r.samples.size() >= MIN_P99_SAMPLES) std::cout << r.p99;  // empty below that
+        std::cout << "," << r.mean << "," << r.ci95 << "," << r.stddev << "," << (r.noisy ? 1 : 0) << ",";
+        for (size_t c = 0; c < r.counters.size(); ++c) {
+            std::cout << (c ? ";" : "") << r.counters[c].first << "=" << r.counters[c].second;
+        }
+        std::cout << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto& options = benchmarkOptions();
+    bool list = false;
+    if (!parseArguments(argc, argv, options, list)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::regex filter(options.filter.empty() ? ".*" : options.filter);
+    for (const auto& design : designRegistry()) {
+        if (!std::regex_search(design.name, filter)) continue;
+        if (list) {
+            std::cout << design.name << "\n";
+            continue;
+        }
+        for (size_t size : options.sizes) {
+            for (TypeMix mix : options.mixes) {
+                for (AllocatorMode allocator : options.allocators) {
+                    for (size_t repetition = 0; repetition < options.repetitions; ++repetition) {
+                        benchmarkContext() = {design.name, repetition, mix, size, allocator, design.labelSuffix};
+                        heapScatter().reset(options.scatter, size, options.seed);
+                        instrumentAllocator().reset(allocator, size);
+                        design.run();
+                    }
+                }
+            }
+        }
+        heapScatter().reset(ScatterMode::None, 0, options.seed);
+        instrumentAllocator().reset(AllocatorMode::Malloc, 0);
+    }
+
+    if (options.format == OutputFormat::Json) {
+        writeResultsJson(std::cout, benchmarkResults());
+        std::cout << "\n";
+    }
+    if (options.format == OutputFormat::Csv) writeCsv(benchmarkResults());
+
+    if (!options.saveDir.empty()) {
+        RunInfo info = currentRunInfo();
+        std::error_code error;
+        std::filesystem::create_directories(options.saveDir, error);
+        std::string path = options.saveDir + "/" + storeFileName(info);
+        if (!saveRun(path, info, benchmarkResults())) {
+            std::cerr << "Cannot write results to " << path << "\n";
+            return 1;
+        }
+        std::cerr << "Saved results to " << path << "\n";
+    }
+    if (!options.baseline.empty()) {
+        RunInfo baselineInfo;
+        std::vector<BenchmarkResult> baseline;
+        if (!loadRun(options.baseline, baselineInfo, baseline)) {
+            std::cerr << "Cannot read results from " << options.baseline << "\n";
+            return 1;
+        }
+        // Keep stdout machine-readable when it carries JSON or CSV
+        std::ostream& out = options.format == OutputFormat::Text ? std::cout : std::cerr;
+        out << "\nBaseline: " << options.baseline << " (commit " << baselineInfo.commit << ", "
+            << baselineInfo.compiler << ", " << baselineInfo.cpu << ")\n";
+        if (compareRuns(out, baseline, benchmarkResults(), options.regressionThreshold) > 0) return 1;
+    }
+    return 0;
+}
@@ -1,20 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <vector>
 #include <memory>
 #include <iostream>
+#include <string>
+
+#include "allocation.h"
+#include "option_model.h"
+#include "perf_counters.h"
+#include "registry.h"
+#include "workload.h"
 
 constexpr size_t ITERATIONS = 10'000;
-constexpr size_t SAMPLE_SIZE = ITERATIONS;  // 2 data points per iteration 
+constexpr size_t SAMPLE_SIZE = ITERATIONS;  // 2 data points per iteration
+
+// Book sizes run by --sweep, from L1-resident up to well past any last-level cache.
+inline const std::vector<size_t> SWEEP_SIZES = {1'000, 10'000, 100'000, 1'000'000, 10'000'000, 100'000'000};
+
+// The timed passes are split into SAMPLES independent samples after an untimed warmup of a tenth
+// of the timed work (WARMUP_ITERATIONS per ITERATIONS).
+constexpr size_t SAMPLES = 50;
+constexpr size_t WARMUP_ITERATIONS = ITERATIONS / 10;
+
+// Below this many samples p99 is just the largest one or two, so it is left out (reported as 0).
+constexpr size_t MIN_P99_SAMPLES = 100;
+
+// A run whose samples spread more than this (stddev / mean) is retried, then flagged as noisy.
+constexpr double MAX_RELATIVE_STDDEV = 0.05;
+constexpr int MAX_ATTEMPTS = 3;
+
+// Slowdown against a stored baseline, as a fraction of its median, that --baseline reports as a
+// regression when it is also statistically significant (results_store.h).
+constexpr double DEFAULT_REGRESSION_THRESHOLD = 0.05;
+
+// Forces a value to be materialized so the optimizer cannot drop the computation producing it.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<const volatile char*>(static_cast<const void*>(&value)));
+#endif
+}
+
+// Makes all pending memory writes observable, for designs that store prices into output buffers.
+inline void clobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#else
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+enum class OutputFormat { Text, Json, Csv };
+
+// Set by the driver from the command line before any design runs.
+struct BenchmarkOptions {
+    std::string filter;
+    size_t repetitions = 1;
+    OutputFormat format = OutputFormat::Text;
+    bool perfCounters = perfCountersRequested();
+    std::vector<TypeMix> mixes = {TypeMix::Alternating, TypeMix::Shuffled, TypeMix::Skewed, TypeMix::Bursty};
+    std::vector<InstrumentKind> replay;  // loaded from --mix-file, enables TypeMix::Replay
+    uint64_t seed = DEFAULT_WORKLOAD_SEED;
+    std::vector<size_t> sizes = {SAMPLE_SIZE};
+    ScatterMode scatter = ScatterMode::None;
+    std::vector<AllocatorMode> allocators = {AllocatorMode::Malloc};
+    std::vector<size_t> threads;  // thread counts for the scaling runs, empty to skip them
+    bool pinThreads = true;
+    bool packedOutput = false;
+    std::vector<size_t> tickRates = {100'000, 1'000'000, 0};  // ticks/s for the tick pipeline, 0 unthrottled
+    std::string tickFile;  // replayed by the tick pipeline instead of synthetic ticks when set
+    std::vector<size_t> serviceRates = {100'000, 1'000'000, 0};  // requests/s for the pricing service, 0 saturates
+    std::string saveDir;  // results store directory for --save
+    std::string baseline;  // stored run to compare against
+    double regressionThreshold = DEFAULT_REGRESSION_THRESHOLD;
+};
+
+inline BenchmarkOptions& benchmarkOptions() {
+    static BenchmarkOptions options;
+    return options;
+}
+
+// Identifies the design and repetition currently being run, stamped onto every result.
+struct BenchmarkContext {
+    std::string design;
+    size_t repetition = 0;
+    TypeMix mix = TypeMix::Alternating;
+    size_t bookSize = SAMPLE_SIZE;
+    AllocatorMode allocator = AllocatorMode::Malloc;
+    std::string labelSuffix;
+};
+
+inline BenchmarkContext& benchmarkContext() {
+    static BenchmarkContext context;
+    return context;
+}
+
+// Number of instruments in the book under test: SAMPLE_SIZE unless the driver sweeps sizes.
+inline size_t bookSize() { return benchmarkContext().bookSize; }
+
+// Instrument types for a book of n items under the workload mix currently being run.
+inline std::vector<InstrumentKind> workloadTypes(size_t n = bookSize()) {
+    const auto& options = benchmarkOptions();
+    return makeTypeSequence(benchmarkContext().mix, n, options.seed, options.replay);
+}
+
+struct BenchmarkResult {
+    std::string design;
+    size_t repetition = 0;
+    std::string workload;
+    size_t bookSize = 0;
+    std::string scatter;
+    std::string allocator;
+    std::string label;
+    std::vector<double> samples;  // ns per priced item, one entry per sample
+    double min = 0;
+    double median = 0;
+    double p90 = 0;
+    double p99 = 0;  // 0 when there are fewer than MIN_P99_SAMPLES samples
+    double mean = 0;
+    double stddev = 0;
+    double ci95 = 0;  // half-width of the 95% confidence interval of the mean
+    bool noisy = false;
+    CounterValues counters;  // hardware events per priced item, empty when not captured
+};
+
+// Every result produced in this process, in run order, for the machine-readable reports.
+inline std::vector<BenchmarkResult>& benchmarkResults() {
+    static std::vector<BenchmarkResult> results;
+    return results;
+}
 
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+inline void summarize(BenchmarkResult& result) {
+    std::vector<double> sorted = result.samples;
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+
+    double sum = 0;
+    for (double s : sorted) sum += s;
+    result.mean = sum / n;
+
+    double squares = 0;
+    for (double s : sorted) squares += (s - result.mean) * (s - result.mean);
+    result.stddev = n > 1 ? std::sqrt(squares / (n - 1)) : 0;
+    result.ci95 = 1.96 * result.stddev / std::sqrt(static_cast<double>(n));
+
+    result.min = sorted.front();
+    result.median = percentile(sorted, 0.5);
+    result.p90 = percentile(sorted, 0.9);
+    result.p99 = n >= MIN_P99_SAMPLES ? percentile(sorted, 0.99) : 0;
+    result.noisy = result.mean > 0 && result.stddev / result.mean > MAX_RELATIVE_STDDEV;
+}
+
+inline void report(const BenchmarkResult& result) {
+    std::cout << result.label << " [" << result.workload << ", " << result.bookSize << " items"
+              << (result.scatter != "none" ? ", scatter " + result.scatter : "")
+              << (result.allocator != "malloc" ? ", " + result.allocator : "") << "] - Median: " << result.median << " ns/iter"
+              << " (min " << result.min << ", p90 " << result.p90;
+    if (result.samples.size() >= MIN_P99_SAMPLES) std::cout << ", p99 " << result.p99;
+    std::cout << ", mean " << result.mean << " +/- " << result.ci95 << " at 95%, stddev " << result.stddev
+              << ", " << result.samples.size() << " samples)"
+              << (result.noisy ? " [NOISY]" : "") << "\n";
+    if (!result.counters.empty()) {
+        std::cout << "    per instrument:";
+        for (const auto& [name, value] : result.counters) std::cout << " " << name << " " << value;
+        std::cout << "\n";
+    }
+}
+
+inline BenchmarkResult newResult(const std::string& label, size_t items) {
+    BenchmarkResult result;
+    result.design = benchmarkContext().design;
+    result.repetition = benchmarkContext().repetition;
+    result.workload = typeMixName(benchmarkContext().mix);
+    result.bookSize = items;
+    result.scatter = scatterModeName(benchmarkOptions().scatter);
+    result.allocator = allocatorModeName(benchmarkContext().allocator);
+    result.label = label + benchmarkContext().labelSuffix;
+    return result;
+}
+
+// Times func() pricing `items` instruments per pass, reported per instrument. `iterations` counts
+// passes over a SAMPLE_SIZE book; larger books run proportionally fewer passes so every size prices
+// roughly the same number of instruments.
 template <typename Func>
-void benchmark(const std::string& label, Func func, size_t iterations) {
-    auto start = std::chrono::high_resolution_clock::now();
-    for (size_t i = 0; i < iterations; ++i) {
-        func();
+BenchmarkResult benchmark(const std::string& label, Func func, size_t iterations, size_t items = bookSize()) {
+    using Clock = std::chrono::steady_clock;
+    size_t passesPerSample = std::max<size_t>(1, iterations * SAMPLE_SIZE / items / SAMPLES);
+    size_t warmupPasses = std::max<size_t>(1, iterations * WARMUP_ITERATIONS / ITERATIONS * SAMPLE_SIZE / items);
+
+    BenchmarkResult result = newResult(label, items);
+    std::unique_ptr<PerfCounters> perf;
+    if (benchmarkOptions().perfCounters) {
+        perf = std::make_unique<PerfCounters>();
+        if (!perf->available()) {
+            std::cerr << "    perf counters unavailable, reporting timing only\n";
+            perf.reset();
+        }
+    }
+
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+        for (size_t i = 0; i < warmupPasses; ++i) {
+            func();
+        }
+
+        result.samples.clear();
+        if (perf) perf->start();
+        for (size_t s = 0; s < SAMPLES; ++s) {
+            auto start = Clock::now();
+            for (size_t i = 0; i < passesPerSample; ++i) {
+                func();
+            }
+            auto end = Clock::now();
+
+            auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+            result.samples.push_back(static_cast<double>(total_ns) / passesPerSample / items);
+        }
+        if (perf) {
+            perf->stop();
+            result.counters = perf->read();
+            for (auto& counter : result.counters) counter.second /= static_cast<double>(SAMPLES * passesPerSample * items);
+        }
+
+        summarize(result);
+        if (!result.noisy) break;
     }
-    auto end = std::chrono::high_resolution_clock::now();
-    
-    auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    double average_ns = static_cast<double>(total_ns) / iterations / SAMPLE_SIZE;
-    std::cout << label << " - Average: " << average_ns << " ns/iter\n";
+
+    if (benchmarkOptions().format == OutputFormat::Text) report(result);
+    benchmarkResults().push_back(result);
+    return result;
+}
+
+// One-shot timing for work too expensive to repeat SAMPLES times, such as building a whole book.
+// Each run calls func(stop) and is timed until func calls stop(), so teardown after stop() is not
+// counted. Reported per instrument like benchmark(), with one sample per run.
+template <typename Func>
+BenchmarkResult benchmarkOnce(const std::string& label, Func func, size_t runs, size_t items = bookSize()) {
+    using Clock = std::chrono::steady_clock;
+    BenchmarkResult result = newResult(label, items);
+    for (size_t run = 0; run < runs; ++run) {
+        auto start = Clock::now();
+        Clock::time_point end;
+        func([&]() { end = Clock::now(); });
+        auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        result.samples.push_back(static_cast<double>(total_ns) / items);
+    }
+    summarize(result);
+
+    if (benchmarkOptions().format == OutputFormat::Text) report(result);
+    benchmarkResults().push_back(result);
+    return result;
 }
@@ -0,0 +1,10 @@
+#include "black_scholes.h"
+#include "greeks.h"
+
+void priceBlackScholesScalar(const BlackScholesInputs& in, double* out) {
+    priceBlackScholesLanes<ScalarLane>(in, out);
+}
+
+void priceGreeksScalar(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out) {
+    priceGreeksLanes<ScalarLane>(method, in, out);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "instrument_book.h"
+#include "vector_math.h"
+
+// Black-Scholes pricing of European options, per call (ScalarLane) or in batches over columnar
+// inputs with scalar, AVX2 and AVX-512 kernels. All paths share the approximations documented in
+// vector_math.h; the normal CDF dominates the error, so prices are within
+// 7.5e-8 * (spot + strike) of blackScholesReference().
+
+struct OptionTerms {
+    double spot;
+    double strike;
+    double rate;
+    double expiry;  // in years
+    double volatility;
+    bool isCall;
+};
+
+// Deterministic spread of strikes, expiries and vols so benchmarks see realistic, varied inputs.
+inline OptionTerms sampleOptionTerms(size_t i) {
+    return {100.0, 80.0 + (i % 41), 0.03, 0.25 + (i % 8) * 0.25, 0.1 + (i % 9) * 0.05, i % 2 == 0};
+}
+
+// Inputs of a batch as raw column pointers; callPut is +1 for a call and -1 for a put.
+struct BlackScholesInputs {
+    const double* spot;
+    const double* strike;
+    const double* rate;
+    const double* expiry;
+    const double* volatility;
+    const double* callPut;
+    size_t size;
+};
+
+struct BlackScholesColumns {
+    AlignedVector<double> spot;
+    AlignedVector<double> strike;
+    AlignedVector<double> rate;
+    AlignedVector<double> expiry;
+    AlignedVector<double> volatility;
+    AlignedVector<double> callPut;
+
+    void add(const OptionTerms& terms) {
+        spot.push_back(terms.spot);
+        strike.push_back(terms.strike);
+        rate.push_back(terms.rate);
+        expiry.push_back(terms.expiry);
+        volatility.push_back(terms.volatility);
+        callPut.push_back(terms.isCall ? 1.0 : -1.0);
+    }
+
+    size_t size() const { return spot.size(); }
+
+    BlackScholesInputs inputs() const {
+        return {spot.data(), strike.data(), rate.data(), expiry.data(), volatility.data(), callPut.data(), size()};
+    }
+};
+
+// Call: S N(d1) - K e^{-rT} N(d2). Put: K e^{-rT} N(-d2) - S N(-d1). Both are
+// callPut * (S N(callPut d1) - K e^{-rT} N(callPut d2)).
+template <typename L>
+inline L blackScholes(L spot, L strike, L rate, L expiry, L volatility, L callPut) {
+    L deviation = volatility * L::sqrt(expiry);
+    L d1 = (vlog(spot / strike) + (rate + L::splat(0.5) * volatility * volatility) * expiry) / deviation;
+    L d2 = d1 - deviation;
+    L discount = vexp(L::splat(0.0) - rate * expiry);
+    return callPut * (spot * vnormCdf(callPut * d1) - strike * discount * vnormCdf(callPut * d2));
+}
+
+inline double blackScholesPrice(const OptionTerms& terms) {
+    return blackScholes(ScalarLane{terms.spot}, ScalarLane{terms.strike}, ScalarLane{terms.rate},
+                        ScalarLane{terms.expiry}, ScalarLane{terms.volatility},
+                        ScalarLane{terms.isCall ? 1.0 : -1.0}).v;
+}
+
+// libm-based reference for accuracy checks.
+inline double blackScholesReference(const OptionTerms& terms) {
+    auto normCdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+    double deviation = terms.volatility * std::sqrt(terms.expiry);
+    double d1 = (std::log(terms.spot / terms.strike) + (terms.rate + 0.5 * terms.volatility * terms.volatility) * terms.expiry) / deviation;
+    double d2 = d1 - deviation;
+    double discount = std::exp(-terms.rate * terms.expiry);
+    double sign = terms.isCall ? 1.0 : -1.0;
+    return sign * (terms.spot * normCdf(sign * d1) - terms.strike * discount * normCdf(sign * d2));
+}
+
+// Batch loop for one lane type. The tail is padded with a harmless option so every kernel stays
+// in its own instruction set.
+template <typename L>
+inline void priceBlackScholesLanes(const BlackScholesInputs& in, double* out) {
+    size_t i = 0;
+    for (; i + L::WIDTH <= in.size; i += L::WIDTH) {
+        blackScholes(L::load(in.spot + i), L::load(in.strike + i), L::load(in.rate + i), L::load(in.expiry + i),
+                     L::load(in.volatility + i), L::load(in.callPut + i)).store(out + i);
+    }
+    if (i == in.size) return;
+
+    double tail[6][L::WIDTH];
+    const double* columns[6] = {in.spot, in.strike, in.rate, in.expiry, in.volatility, in.callPut};
+    const double padding[6] = {1.0, 1.0, 0.0, 1.0, 0.2, 1.0};
+    for (size_t c = 0; c < 6; ++c) {
+        for (size_t lane = 0; lane < L::WIDTH; ++lane) {
+            tail[c][lane] = i + lane < in.size ? columns[c][i + lane] : padding[c];
+        }
+    }
+    double prices[L::WIDTH];
+    blackScholes(L::load(tail[0]), L::load(tail[1]), L::load(tail[2]), L::load(tail[3]), L::load(tail[4]),
+                 L::load(tail[5])).store(prices);
+    for (size_t lane = 0; i + lane < in.size; ++lane) out[i + lane] = prices[lane];
+}
+
+// Defined in black_scholes.cpp, black_scholes_avx2.cpp and black_scholes_avx512.cpp. The AVX
+// variants fall back to the scalar kernel when built for a target without that instruction set.
+void priceBlackScholesScalar(const BlackScholesInputs& in, double* out);
+void priceBlackScholesAvx2(const BlackScholesInputs& in, double* out);
+void priceBlackScholesAvx512(const BlackScholesInputs& in, double* out);
+
+inline void priceBlackScholes(SimdLevel level, const BlackScholesInputs& in, double* out) {
+    if (level == SimdLevel::Avx512) return priceBlackScholesAvx512(in, out);
+    if (level == SimdLevel::Avx2) return priceBlackScholesAvx2(in, out);
+    priceBlackScholesScalar(in, out);
+}
@@ -0,0 +1,20 @@
+// Compiled with AVX2 and FMA enabled; only reached when the CPU supports them.
+#include "black_scholes.h"
+#include "greeks.h"
+#include "simd_lanes.h"
+
+void priceBlackScholesAvx2(const BlackScholesInputs& in, double* out) {
+#ifdef __AVX2__
+    priceBlackScholesLanes<Avx2Lane>(in, out);
+#else
+    priceBlackScholesScalar(in, out);
+#endif
+}
+
+void priceGreeksAvx2(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out) {
+#ifdef __AVX2__
+    priceGreeksLanes<Avx2Lane>(method, in, out);
+#else
+    priceGreeksScalar(method, in, out);
+#endif
+}
@@ -0,0 +1,20 @@
+// Compiled with AVX-512F enabled; only reached when the CPU supports it.
+#include "black_scholes.h"
+#include "greeks.h"
+#include "simd_lanes.h"
+
+void priceBlackScholesAvx512(const BlackScholesInputs& in, double* out) {
+#ifdef __AVX512F__
+    priceBlackScholesLanes<Avx512Lane>(in, out);
+#else
+    priceBlackScholesScalar(in, out);
+#endif
+}
+
+void priceGreeksAvx512(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out) {
+#ifdef __AVX512F__
+    priceGreeksLanes<Avx512Lane>(method, in, out);
+#else
+    priceGreeksScalar(method, in, out);
+#endif
+}
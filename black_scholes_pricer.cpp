@@ -0,0 +1,91 @@
+#include "benchmark.h"
+#include "black_scholes.h"
+#include "parallel_engine.h"
+
+namespace {
+
+class OptionPricer;
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+    virtual double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData() : priceFactor(1.2) {}
+    double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
+private:
+    double priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    OptionData(OptionPricer* p, const OptionTerms& t) : pricer(p), terms(t) {}
+    double calculatePrice() const override;
+    OptionPricer* pricer;
+    OptionTerms terms;
+};
+
+class OptionPricer {
+public:
+    double calculatePrice(const OptionData& data) const { return blackScholesPrice(data.terms); }
+};
+
+double OptionData::calculatePrice() const { return pricer->calculatePrice(*this); }
+
+SPEEDFP_DESIGN(black_scholes_pricer) {
+    OptionPricer optionPricer;
+
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    InstrumentBook book;
+    BlackScholesColumns options;
+    std::vector<OptionTerms> terms;
+    auto types = workloadTypes();
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (types[i] == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+            book.addStock(1.2);
+        } else {
+            terms.push_back(sampleOptionTerms(i));
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, terms.back()));
+            options.add(terms.back());
+        }
+    }
+
+    benchmark("Design: Virtual function, Black-Scholes options", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(data->calculatePrice());
+        }
+    }, ITERATIONS);
+
+    benchmarkScaling("Design: Virtual function, Black-Scholes options", dataSamples, [](const auto& data) {
+        return data->calculatePrice();
+    });
+
+    AlignedVector<double> stockPrices(book.stocks.priceFactor.size());
+    AlignedVector<double> optionPrices(options.size());
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (!simdLevelSupported(level)) continue;
+        std::string label = std::string("Design: SoA batch, Black-Scholes ") + simdLevelName(level) + " kernel";
+        benchmark(label, [&]() {
+            priceColumn(level, book.stocks.priceFactor.data(), book.stocks.commonFactor.data(), STOCK_SCALE,
+                        stockPrices.data(), stockPrices.size());
+            priceBlackScholes(level, options.inputs(), optionPrices.data());
+            clobberMemory();
+        }, ITERATIONS);
+
+        if (benchmarkOptions().format != OutputFormat::Text) continue;
+        double maxError = 0;
+        for (size_t i = 0; i < terms.size(); ++i) {
+            maxError = std::max(maxError, std::abs(optionPrices[i] - blackScholesReference(terms[i])));
+        }
+        std::cout << "    max |price - libm reference| over " << terms.size() << " options: " << maxError << "\n";
+    }
+}
+
+} // namespace
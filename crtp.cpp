@@ -1,6 +1,9 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
 #include <variant>
 
+namespace {
+
 template <typename Derived>
 class Data {
 public:
@@ -25,31 +28,40 @@ private:
 
 class OptionData : public Data<OptionData> {
 public:
-    OptionData() : volatility(0.8) {}
+    explicit OptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
     double calculatePriceImpl() const {
-        return volatility * 2.5 + getCommonFactor();
+        return optionPrice(volatility, getCommonFactor(), contract);
     }
     double getVolatility() const { return volatility; }
 private:
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 using DataVariant = std::variant<StockData, OptionData>;
 
-int main() {
+SPEEDFP_DESIGN(crtp) {
     std::vector<DataVariant> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(StockData{});
-        dataSamples.emplace_back(OptionData{});
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData{});
+        } else {
+            dataSamples.emplace_back(OptionData(optionContract(options++)));
+        }
     }
     
     benchmark("Design: CRTP with variant", [&]() {
         for (const auto& var : dataSamples) {
             std::visit([](const auto& data) {
-                data.calculatePrice();
+                doNotOptimize(data.calculatePrice());
             }, var);
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: CRTP with variant", dataSamples, [](const auto& var) {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, var);
+    });
+}
+
+} // namespace
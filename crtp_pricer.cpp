@@ -1,8 +1,11 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
 #include <variant>
 #include <iostream>
 #include <vector>
 
+namespace {
+
 template <typename Derived, typename DataType>
 class Pricer {
 public:
@@ -40,12 +43,14 @@ private:
 
 class OptionData : public Data<OptionData> {
 public:
-    OptionData(OptionPricer* p);
+    OptionData(OptionPricer* p, const OptionContract& terms);
     double calculatePriceImpl() const;
     double getVolatility() const;
+    const OptionContract& getContract() const { return contract; }
 private:
     double volatility;
     OptionPricer* pricer;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 // Pricer class definitions
@@ -59,7 +64,7 @@ public:
 class OptionPricer : public Pricer<OptionPricer, OptionData> {
 public:
     double calculatePriceImpl(const OptionData& data) const {
-        return data.getVolatility() * 2.5 + data.getCommonFactor();
+        return optionPrice(data.getVolatility(), data.getCommonFactor(), data.getContract());
     }
 };
 
@@ -68,19 +73,23 @@ StockData::StockData(StockPricer* p) : priceFactor(1.2), pricer(p) {}
 double StockData::calculatePriceImpl() const { return pricer->calculatePrice(*this); }
 double StockData::getPriceFactor() const { return priceFactor; }
 
-OptionData::OptionData(OptionPricer* p) : volatility(0.8), pricer(p) {}
+OptionData::OptionData(OptionPricer* p, const OptionContract& terms) : volatility(0.8), pricer(p), contract(terms) {}
 double OptionData::calculatePriceImpl() const { return pricer->calculatePrice(*this); }
 double OptionData::getVolatility() const { return volatility; }
 
 using DataVariant = std::variant<StockData, OptionData>;
 
-int main() {
+SPEEDFP_DESIGN(crtp_pricer) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
     std::vector<DataVariant> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(StockData(&stockPricer));
-        dataSamples.emplace_back(OptionData(&optionPricer));
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData(&stockPricer));
+        } else {
+            dataSamples.emplace_back(OptionData(&optionPricer, optionContract(options++)));
+        }
     }
     
     // auto data = dataSamples[0];
@@ -90,10 +99,14 @@ int main() {
     benchmark("Design: CRTP with Pricer", [&]() {
         for (const auto& var : dataSamples) {
             std::visit([&](const auto& data) {
-                data.calculatePrice();
+                doNotOptimize(data.calculatePrice());
             }, var);
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: CRTP with Pricer", dataSamples, [](const auto& var) {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, var);
+    });
+}
+
+} // namespace
@@ -0,0 +1,131 @@
+#include <random>
+
+#include "benchmark.h"
+#include "curves.h"
+
+namespace {
+
+constexpr size_t BOOK_PILLARS = 16;
+constexpr size_t PILLAR_COUNTS[] = {4, 16, 64, 256};
+// A lookup costs several times a plain price; fewer passes keep each run short.
+constexpr size_t LOOKUP_ITERATIONS = ITERATIONS / 20;
+
+class StockPricer;
+class OptionPricer;
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData(StockPricer* p, double t) : pricer(p), priceFactor(1.2), tenor(t) {}
+    double calculatePrice() const override;
+    StockPricer* pricer;
+    double priceFactor;
+    double tenor;  // settlement horizon discounted on the curve
+};
+
+class OptionData : public Data {
+public:
+    OptionData(OptionPricer* p, double e, double k)
+        : pricer(p), expiry(e), strike(k), contract(optionContract(OptionTerms{100.0, k, 0.03, e, 0.0, true})) {}
+    double calculatePrice() const override;
+    OptionPricer* pricer;
+    double expiry;
+    double strike;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class StockPricer {
+public:
+    explicit StockPricer(const YieldCurve& c) : curve(c) {}
+    double calculatePrice(const StockData& data) const {
+        return data.priceFactor * 1.1 * curve.discountFactor(data.tenor) + data.getCommonFactor();
+    }
+private:
+    const YieldCurve& curve;
+};
+
+class OptionPricer {
+public:
+    explicit OptionPricer(const VolSurface& s) : surface(s) {}
+    double calculatePrice(const OptionData& data) const {
+        return optionPrice(surface.vol(data.expiry, data.strike), data.getCommonFactor(), data.contract);
+    }
+private:
+    const VolSurface& surface;
+};
+
+double StockData::calculatePrice() const { return pricer->calculatePrice(*this); }
+double OptionData::calculatePrice() const { return pricer->calculatePrice(*this); }
+
+SPEEDFP_DESIGN(curve_pricer) {
+    std::mt19937_64 rng(benchmarkOptions().seed);
+    std::uniform_real_distribution<double> tenorDist(0.0, 30.0), expiryDist(0.05, 5.0), strikeDist(40.0, 160.0);
+
+    YieldCurve bookCurve = sampleYieldCurve(BOOK_PILLARS, Interpolation::Linear);
+    VolSurface bookSurface = sampleVolSurface(BOOK_PILLARS, BOOK_PILLARS, Interpolation::Linear);
+    StockPricer stockPricer(bookCurve);
+    OptionPricer optionPricer(bookSurface);
+
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer, tenorDist(rng)));
+        } else {
+            double expiry = expiryDist(rng);
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, expiry, strikeDist(rng)));
+        }
+    }
+
+    benchmark("Design: Virtual function, curve and surface lookups", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(data->calculatePrice());
+        }
+    }, ITERATIONS);
+
+    // Lookup microbenchmarks over random query columns, one lookup per item.
+    size_t queries = bookSize();
+    AlignedVector<double> tenors(queries), expiries(queries), strikes(queries), out(queries);
+    for (size_t i = 0; i < queries; ++i) {
+        tenors[i] = tenorDist(rng);
+        expiries[i] = expiryDist(rng);
+        strikes[i] = strikeDist(rng);
+    }
+
+    for (Interpolation interp : {Interpolation::Linear, Interpolation::CubicSpline}) {
+        for (size_t pillars : PILLAR_COUNTS) {
+            YieldCurve curve = sampleYieldCurve(pillars, interp);
+            std::string label = std::string("Design: Yield curve, ") + std::to_string(pillars) + " pillars, " +
+                                interpolationName(interp);
+            benchmark(label + ", per call", [&]() {
+                for (size_t i = 0; i < queries; ++i) out[i] = curve.discountFactor(tenors[i]);
+                clobberMemory();
+            }, LOOKUP_ITERATIONS);
+            benchmark(label + ", batched", [&]() {
+                curve.discountFactors(tenors.data(), out.data(), queries);
+                clobberMemory();
+            }, LOOKUP_ITERATIONS);
+
+            VolSurface surface = sampleVolSurface(pillars, pillars, interp);
+            label = std::string("Design: Vol surface, ") + std::to_string(pillars) + "x" + std::to_string(pillars) +
+                    " pillars, " + interpolationName(interp);
+            benchmark(label + ", per call", [&]() {
+                for (size_t i = 0; i < queries; ++i) out[i] = surface.vol(expiries[i], strikes[i]);
+                clobberMemory();
+            }, LOOKUP_ITERATIONS);
+            benchmark(label + ", batched", [&]() {
+                surface.vols(expiries.data(), strikes.data(), out.data(), queries);
+                clobberMemory();
+            }, LOOKUP_ITERATIONS);
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "instrument_book.h"
+
+// Yield curves and volatility surfaces over pillars held in flat, aligned columns. Lookups find
+// the bracketing pillars with a branch-free binary search (the loop count depends only on the
+// pillar count, and each halving is a conditional move), so a batch of queries can run the search
+// for several points in lockstep and overlap their cache misses. Values are flat beyond the first
+// and last pillar.
+
+enum class Interpolation { Linear, CubicSpline };
+
+inline const char* interpolationName(Interpolation interpolation) {
+    return interpolation == Interpolation::Linear ? "linear" : "cubic spline";
+}
+
+// Index i of the pillar interval [pillars[i], pillars[i + 1]] holding x, clamped to [0, n - 2].
+inline size_t bracketPillar(const double* pillars, size_t n, double x) {
+    const double* base = pillars;
+    for (size_t len = n; len > 1;) {
+        size_t half = len / 2;
+        base = base[half] <= x ? base + half : base;
+        len -= half;
+    }
+    return std::min<size_t>(base - pillars, n - 2);
+}
+
+// bracketPillar for a batch, BRACKET_LANES queries at a time in lockstep.
+constexpr size_t BRACKET_LANES = 8;
+
+inline void bracketPillars(const double* pillars, size_t n, const double* xs, size_t* intervals, size_t count) {
+    size_t i = 0;
+    for (; i + BRACKET_LANES <= count; i += BRACKET_LANES) {
+        const double* base[BRACKET_LANES];
+        for (size_t lane = 0; lane < BRACKET_LANES; ++lane) base[lane] = pillars;
+        for (size_t len = n; len > 1;) {
+            size_t half = len / 2;
+            for (size_t lane = 0; lane < BRACKET_LANES; ++lane) {
+                base[lane] = base[lane][half] <= xs[i + lane] ? base[lane] + half : base[lane];
+            }
+            len -= half;
+        }
+        for (size_t lane = 0; lane < BRACKET_LANES; ++lane) {
+            intervals[i + lane] = std::min<size_t>(base[lane] - pillars, n - 2);
+        }
+    }
+    for (; i < count; ++i) intervals[i] = bracketPillar(pillars, n, xs[i]);
+}
+
+// Natural cubic spline (zero curvature at both ends): solves the second derivatives y2 of the
+// n points (xs, ys) with the usual tridiagonal sweep.
+inline void solveNaturalSpline(const double* xs, const double* ys, double* y2, size_t n) {
+    std::vector<double> u(n, 0.0);
+    y2[0] = 0.0;
+    for (size_t i = 1; i + 1 < n; ++i) {
+        double sig = (xs[i] - xs[i - 1]) / (xs[i + 1] - xs[i - 1]);
+        double p = sig * y2[i - 1] + 2.0;
+        y2[i] = (sig - 1.0) / p;
+        double slope = (ys[i + 1] - ys[i]) / (xs[i + 1] - xs[i]) - (ys[i] - ys[i - 1]) / (xs[i] - xs[i - 1]);
+        u[i] = (6.0 * slope / (xs[i + 1] - xs[i - 1]) - sig * u[i - 1]) / p;
+    }
+    y2[n - 1] = 0.0;
+    for (size_t i = n - 1; i-- > 0;) y2[i] = y2[i] * y2[i + 1] + u[i];
+}
+
+// Interpolates inside interval i, which brackets x or is the end interval next to it.
+inline double interpolatePillars(const double* xs, const double* ys, const double* y2, Interpolation interpolation,
+                                 size_t i, double x) {
+    double h = xs[i + 1] - xs[i];
+    double b = std::clamp((x - xs[i]) / h, 0.0, 1.0);
+    double a = 1.0 - b;
+    double y = a * ys[i] + b * ys[i + 1];
+    if (interpolation == Interpolation::Linear) return y;
+    return y + ((a * a * a - a) * y2[i] + (b * b * b - b) * y2[i + 1]) * h * h / 6.0;
+}
+
+// Queries per batch chunk; the bracket indices of one chunk live on the stack.
+constexpr size_t LOOKUP_CHUNK = BRACKET_LANES * 32;
+
+// One interpolated function of x over at least two pillars.
+class PillarCurve {
+public:
+    PillarCurve(const std::vector<double>& xs, const std::vector<double>& ys, Interpolation interp)
+        : pillars(xs.begin(), xs.end()), ordinates(ys.begin(), ys.end()), secondDerivatives(xs.size(), 0.0),
+          interpolation(interp) {
+        if (interpolation == Interpolation::CubicSpline) {
+            solveNaturalSpline(pillars.data(), ordinates.data(), secondDerivatives.data(), pillars.size());
+        }
+    }
+
+    size_t size() const { return pillars.size(); }
+
+    double value(double x) const { return interpolate(bracketPillar(pillars.data(), pillars.size(), x), x); }
+
+    void values(const double* xs, double* out, size_t count) const {
+        size_t intervals[LOOKUP_CHUNK];
+        for (size_t start = 0; start < count; start += LOOKUP_CHUNK) {
+            size_t n = std::min(LOOKUP_CHUNK, count - start);
+            bracketPillars(pillars.data(), pillars.size(), xs + start, intervals, n);
+            for (size_t i = 0; i < n; ++i) out[start + i] = interpolate(intervals[i], xs[start + i]);
+        }
+    }
+
+private:
+    double interpolate(size_t i, double x) const {
+        return interpolatePillars(pillars.data(), ordinates.data(), secondDerivatives.data(), interpolation, i, x);
+    }
+
+    AlignedVector<double> pillars;
+    AlignedVector<double> ordinates;
+    AlignedVector<double> secondDerivatives;
+    Interpolation interpolation;
+};
+
+// Continuously compounded zero rates by tenor in years.
+class YieldCurve {
+public:
+    YieldCurve(const std::vector<double>& tenors, const std::vector<double>& zeroRates, Interpolation interp)
+        : rates(tenors, zeroRates, interp) {}
+
+    double zeroRate(double tenor) const { return rates.value(tenor); }
+    double discountFactor(double tenor) const { return std::exp(-zeroRate(tenor) * tenor); }
+
+    void discountFactors(const double* tenors, double* out, size_t count) const {
+        rates.values(tenors, out, count);
+        for (size_t i = 0; i < count; ++i) out[i] = std::exp(-out[i] * tenors[i]);
+    }
+
+    size_t pillarCount() const { return rates.size(); }
+
+private:
+    PillarCurve rates;
+};
+
+// Implied volatilities on an expiry x strike grid: one strike pillar column shared by every
+// expiry, and row-major vol and spline columns (smile e at offset e * strikes). A lookup brackets
+// the strike once, interpolates the two bracketing smiles, then blends them linearly in total
+// variance (vol^2 * T) across expiry.
+class VolSurface {
+public:
+    // vols[e * strikes.size() + k] is the vol at expiries[e], strikes[k].
+    VolSurface(const std::vector<double>& expiries, const std::vector<double>& strikes,
+               const std::vector<double>& vols, Interpolation interp)
+        : expiryPillars(expiries.begin(), expiries.end()), strikePillars(strikes.begin(), strikes.end()),
+          smiles(vols.begin(), vols.end()), secondDerivatives(vols.size(), 0.0), interpolation(interp) {
+        if (interpolation != Interpolation::CubicSpline) return;
+        for (size_t e = 0; e < expiries.size(); ++e) {
+            size_t row = e * strikes.size();
+            solveNaturalSpline(strikePillars.data(), smiles.data() + row, secondDerivatives.data() + row,
+                               strikes.size());
+        }
+    }
+
+    double vol(double expiry, double strike) const {
+        return blend(bracketPillar(expiryPillars.data(), expiryPillars.size(), expiry),
+                     bracketPillar(strikePillars.data(), strikePillars.size(), strike), expiry, strike);
+    }
+
+    void vols(const double* expiries, const double* strikes, double* out, size_t count) const {
+        size_t expiryIntervals[LOOKUP_CHUNK];
+        size_t strikeIntervals[LOOKUP_CHUNK];
+        for (size_t start = 0; start < count; start += LOOKUP_CHUNK) {
+            size_t n = std::min(LOOKUP_CHUNK, count - start);
+            bracketPillars(expiryPillars.data(), expiryPillars.size(), expiries + start, expiryIntervals, n);
+            bracketPillars(strikePillars.data(), strikePillars.size(), strikes + start, strikeIntervals, n);
+            for (size_t i = 0; i < n; ++i) {
+                out[start + i] = blend(expiryIntervals[i], strikeIntervals[i], expiries[start + i], strikes[start + i]);
+            }
+        }
+    }
+
+    size_t pillarCount() const { return smiles.size(); }
+
+private:
+    double smileVol(size_t e, size_t k, double strike) const {
+        size_t row = e * strikePillars.size();
+        return interpolatePillars(strikePillars.data(), smiles.data() + row, secondDerivatives.data() + row,
+                                  interpolation, k, strike);
+    }
+
+    double blend(size_t e, size_t k, double expiry, double strike) const {
+        double t0 = expiryPillars[e], t1 = expiryPillars[e + 1];
+        double t = std::clamp(expiry, t0, t1);
+        double v0 = smileVol(e, k, strike), v1 = smileVol(e + 1, k, strike);
+        double w = (t - t0) / (t1 - t0);
+        double variance = (1.0 - w) * v0 * v0 * t0 + w * v1 * v1 * t1;
+        return std::sqrt(variance / t);
+    }
+
+    AlignedVector<double> expiryPillars;
+    AlignedVector<double> strikePillars;
+    AlignedVector<double> smiles;
+    AlignedVector<double> secondDerivatives;
+    Interpolation interpolation;
+};
+
+// Deterministic market shapes for benchmarks: an upward-sloping curve and a skewed smile whose
+// level decays with expiry.
+inline YieldCurve sampleYieldCurve(size_t pillars, Interpolation interp) {
+    std::vector<double> tenors, rates;
+    for (size_t i = 0; i < pillars; ++i) {
+        double tenor = 30.0 * (i + 1) / pillars;
+        tenors.push_back(tenor);
+        rates.push_back(0.02 + 0.01 * std::log1p(tenor));
+    }
+    return YieldCurve(tenors, rates, interp);
+}
+
+inline VolSurface sampleVolSurface(size_t expiryPillars, size_t strikePillars, Interpolation interp) {
+    std::vector<double> expiries, strikes, vols;
+    for (size_t e = 0; e < expiryPillars; ++e) expiries.push_back(5.0 * (e + 1) / expiryPillars);
+    for (size_t k = 0; k < strikePillars; ++k) strikes.push_back(50.0 + 100.0 * k / (strikePillars - 1));
+    for (double expiry : expiries) {
+        for (double strike : strikes) {
+            double moneyness = std::log(strike / 100.0);
+            vols.push_back((0.15 + 0.1 / (1.0 + expiry)) * (1.0 - 0.3 * moneyness + 0.5 * moneyness * moneyness));
+        }
+    }
+    return VolSurface(expiries, strikes, vols, interp);
+}
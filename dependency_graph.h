@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Instruments whose inputs changed since the last reprice. A bitset over instrument indices plus a
+// summary bit per 64-bit word, so draining a sparse set skips empty words 64 at a time and the
+// cost follows the number of dirty instruments rather than the book size. Draining visits indices
+// in ascending order, so repricing still walks the book forwards.
+class DirtySet {
+public:
+    void resize(size_t n) {
+        words.assign((n + 63) / 64, 0);
+        summary.assign((words.size() + 63) / 64, 0);
+    }
+
+    void mark(size_t i) {
+        size_t word = i >> 6;
+        words[word] |= uint64_t{1} << (i & 63);
+        summary[word >> 6] |= uint64_t{1} << (word & 63);
+    }
+
+    void markAll(size_t n) {
+        for (size_t i = 0; i < n; ++i) mark(i);
+    }
+
+    // Calls f(index) for every dirty instrument, clears the set and returns how many were visited.
+    template <typename F>
+    size_t drain(F f) {
+        size_t visited = 0;
+        for (size_t s = 0; s < summary.size(); ++s) {
+            for (uint64_t dirtyWords = std::exchange(summary[s], 0); dirtyWords; dirtyWords &= dirtyWords - 1) {
+                size_t word = s * 64 + std::countr_zero(dirtyWords);
+                for (uint64_t bits = std::exchange(words[word], 0); bits; bits &= bits - 1) {
+                    f(word * 64 + std::countr_zero(bits));
+                    ++visited;
+                }
+            }
+        }
+        return visited;
+    }
+
+private:
+    std::vector<uint64_t> words;
+    std::vector<uint64_t> summary;
+};
+
+// Market inputs and the instruments that read them. Instruments subscribe to inputs while the
+// book is built; build() then packs the subscriptions into a compressed (CSR) dependents list per
+// input. update() stores a new value and marks only that input's dependents dirty; reprice()
+// visits just those instruments.
+class MarketGraph {
+public:
+    size_t addInput(double value) {
+        values.push_back(value);
+        return values.size() - 1;
+    }
+
+    void subscribe(size_t instrument, size_t input) {
+        edges.emplace_back(input, instrument);
+        instruments = std::max(instruments, instrument + 1);
+    }
+
+    void build() {
+        std::stable_sort(edges.begin(), edges.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        offsets.assign(values.size() + 1, 0);
+        dependents.clear();
+        for (const auto& [input, instrument] : edges) {
+            ++offsets[input + 1];
+            dependents.push_back(instrument);
+        }
+        for (size_t input = 0; input < values.size(); ++input) offsets[input + 1] += offsets[input];
+        edges.clear();
+        edges.shrink_to_fit();
+        dirty.resize(instruments);
+    }
+
+    double value(size_t input) const { return values[input]; }
+
+    void update(size_t input, double value) {
+        values[input] = value;
+        for (size_t d = offsets[input]; d < offsets[input + 1]; ++d) dirty.mark(dependents[d]);
+    }
+
+    // Stores a value without tracking, for callers that reprice the whole book anyway.
+    void set(size_t input, double value) { values[input] = value; }
+
+    void markAllDirty() { dirty.markAll(instruments); }
+
+    // Calls priceOne(index) for every dirty instrument; returns how many were repriced.
+    template <typename PriceOne>
+    size_t reprice(PriceOne priceOne) {
+        return dirty.drain(priceOne);
+    }
+
+private:
+    std::vector<double> values;
+    std::vector<std::pair<size_t, size_t>> edges;  // (input, instrument), until build()
+    std::vector<size_t> offsets;
+    std::vector<size_t> dependents;
+    size_t instruments = 0;
+    DirtySet dirty;
+};
@@ -1,6 +1,9 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
 #include <variant>
 
+namespace {
+
 class StockPricer;
 class OptionPricer;
 
@@ -23,10 +26,11 @@ public:
 
 class OptionData : public Data {
 public:
-    OptionData(OptionPricer* p) : Data(), pricer(p), volatility(0.8) {}
+    OptionData(OptionPricer* p, const OptionContract& terms) : Data(), pricer(p), volatility(0.8), contract(terms) {}
     double calculatePrice() const ;
     OptionPricer* pricer;
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class StockPricer {
@@ -39,7 +43,7 @@ public:
 class OptionPricer {
 public:
     double calculatePrice(const OptionData* data) const { 
-        return data->volatility * 2.5 + data->getCommonFactor();
+        return optionPrice(data->volatility, data->getCommonFactor(), data->contract);
     }
 };
 
@@ -48,23 +52,31 @@ double OptionData::calculatePrice() const { return pricer->calculatePrice(this);
 
 using DataVariant = std::variant<StockData, OptionData>;
 
-int main() {
+SPEEDFP_DESIGN(derived_pricer_no_virtual) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
 
     std::vector<DataVariant> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(StockData(&stockPricer));
-        dataSamples.emplace_back(OptionData(&optionPricer));
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData(&stockPricer));
+        } else {
+            dataSamples.emplace_back(OptionData(&optionPricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Derived pricer no virtual function", [&]() {
         for (const auto& data : dataSamples) {
             std::visit([&](auto&& arg) {
-                arg.calculatePrice();
+                doNotOptimize(arg.calculatePrice());
             }, data);
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Derived pricer no virtual function", dataSamples, [](const auto& var) {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, var);
+    });
+}
+
+} // namespace
@@ -1,6 +1,9 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
 #include <variant>
 
+namespace {
+
 class StockPricer;
 class OptionPricer;
 
@@ -13,7 +16,7 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData(StockPricer* p) : Data(), pricer(p), priceFactor(1.2) {}
     double calculatePrice() const override;
@@ -21,12 +24,13 @@ public:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData(OptionPricer* p) : Data(), pricer(p), volatility(0.8) {}
+    OptionData(OptionPricer* p, const OptionContract& terms) : Data(), pricer(p), volatility(0.8), contract(terms) {}
     double calculatePrice() const override;
     OptionPricer* pricer;
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class StockPricer {
@@ -39,7 +43,7 @@ public:
 class OptionPricer {
 public:
     double calculatePrice(const OptionData* data) const { 
-        return data->volatility * 2.5 + data->getCommonFactor();
+        return optionPrice(data->volatility, data->getCommonFactor(), data->contract);
     }
 };
 
@@ -48,23 +52,31 @@ double OptionData::calculatePrice() const { return pricer->calculatePrice(this);
 
 using DataVariant = std::variant<StockData, OptionData>;
 
-int main() {
+SPEEDFP_DESIGN(derived_pricer_with_virtual_unused) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
 
     std::vector<DataVariant> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(StockData(&stockPricer));
-        dataSamples.emplace_back(OptionData(&optionPricer));
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData(&stockPricer));
+        } else {
+            dataSamples.emplace_back(OptionData(&optionPricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Derived pricer with virtual unused", [&]() {
         for (const auto& data : dataSamples) {
             std::visit([&](auto&& arg) {
-                arg.calculatePrice();
+                doNotOptimize(arg.calculatePrice());
             }, data);
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Derived pricer with virtual unused", dataSamples, [](const auto& var) {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, var);
+    });
+}
+
+} // namespace
@@ -1,6 +1,9 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
 #include <variant>
 
+namespace {
+
 class StockPricer;
 class OptionPricer;
 
@@ -13,7 +16,7 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData(StockPricer* p) : Data(), pricer(p), priceFactor(1.2) {}
     double calculatePrice() const override;
@@ -21,12 +24,13 @@ public:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData(OptionPricer* p) : Data(), pricer(p), volatility(0.8) {}
+    OptionData(OptionPricer* p, const OptionContract& terms) : Data(), pricer(p), volatility(0.8), contract(terms) {}
     double calculatePrice() const override;
     OptionPricer* pricer;
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class StockPricer {
@@ -39,7 +43,7 @@ public:
 class OptionPricer {
 public:
     double calculatePrice(const OptionData* data) const { 
-        return data->volatility * 2.5 + data->getCommonFactor();
+        return optionPrice(data->volatility, data->getCommonFactor(), data->contract);
     }
 };
 
@@ -47,21 +51,29 @@ double StockData::calculatePrice() const { return pricer->calculatePrice(this);
 double OptionData::calculatePrice() const { return pricer->calculatePrice(this); }
 
 
-int main() {
+SPEEDFP_DESIGN(derived_pricer_with_virtual_used) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
 
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>(&stockPricer));
-        dataSamples.emplace_back(std::make_unique<OptionData>(&optionPricer));
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Derived pricer with virtual used", [&]() {
         for (const auto& data : dataSamples) {
-            data->calculatePrice();
+            doNotOptimize(data->calculatePrice());
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Derived pricer with virtual used", dataSamples, [](const auto& data) {
+        return data->calculatePrice();
+    });
+}
+
+} // namespace
@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class Data {
 public:
@@ -10,7 +13,7 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData() : priceFactor(1.2) {}
     double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
@@ -19,13 +22,14 @@ private:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData() : volatility(0.8) {}
-    double calculatePrice() const override { return volatility * 2.5 + getCommonFactor(); }
+    explicit OptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
+    double calculatePrice() const override { return optionPrice(volatility, getCommonFactor(), contract); }
     bool isStock() const override { return false; }
 private:
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class Pricer {
@@ -33,7 +37,7 @@ public:
     virtual double calculatePrice(const Data* data) const = 0;
 };
 
-class DynamicPricer : public Pricer {
+class DynamicPricer SPEEDFP_FINAL : public Pricer {
 public:
     double calculatePrice(const Data* data) const override {
         if (data->isStock()) {
@@ -46,19 +50,27 @@ public:
     }
 };
 
-int main() {
+SPEEDFP_DESIGN(dynamic_cast_pricer) {
     DynamicPricer pricer;
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>());
-        dataSamples.emplace_back(std::make_unique<OptionData>());
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+        }
     }
     
     benchmark("Design: Dynamic cast with Pricer", [&]() {
         for (const auto& data : dataSamples) {
-            pricer.calculatePrice(data.get());
+            doNotOptimize(pricer.calculatePrice(data.get()));
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Dynamic cast with Pricer", dataSamples, [&](const auto& data) {
+        return pricer.calculatePrice(data.get());
+    });
+}
+
+} // namespace
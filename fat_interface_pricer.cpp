@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class Pricer;  // Forward declaration
 
@@ -15,7 +18,7 @@ protected:
     Pricer* pricer;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData(Pricer* p) : Data(p), priceFactor(1.2) {}
     double getPriceFactor() const override { return priceFactor; }
@@ -23,12 +26,15 @@ private:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData(Pricer* p) : Data(p), volatility(0.8) {}
+    OptionData(Pricer* p, const OptionContract& terms) : Data(p), volatility(0.8), contract(terms) {}
     double getVolatility() const override { return volatility; }
+    // Not part of the fat interface: a virtual getter would be called even while the contract is empty.
+    const OptionContract& getContract() const { return contract; }
 private:
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class Pricer {
@@ -37,36 +43,45 @@ public:
     virtual double calculatePrice(const Data* data) const = 0;
 };
 
-class StockPricer : public Pricer {
+class StockPricer SPEEDFP_FINAL : public Pricer {
 public:
     double calculatePrice(const Data* data) const override {
         return data->getPriceFactor() * 1.1 + data->getCommonFactor(); 
     }
 };
 
-class OptionPricer : public Pricer {
+class OptionPricer SPEEDFP_FINAL : public Pricer {
 public:
     double calculatePrice(const Data* data) const override {
-        return data->getVolatility() * 2.5 + data->getCommonFactor();
+        return optionPrice(data->getVolatility(), data->getCommonFactor(),
+                           static_cast<const OptionData*>(data)->getContract());
     }
 };
 
 double Data::calculatePriceImpl() const { return pricer->calculatePrice(this); }
 
-int main() {
+SPEEDFP_DESIGN(fat_interface_pricer) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>(&stockPricer));
-        dataSamples.emplace_back(std::make_unique<OptionData>(&optionPricer));
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Fat Interface with Pricer", [&]() {
         for (const auto& data : dataSamples) {
-            data->calculatePriceImpl();
+            doNotOptimize(data->calculatePriceImpl());
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Fat Interface with Pricer", dataSamples, [](const auto& data) {
+        return data->calculatePriceImpl();
+    });
+}
+
+} // namespace
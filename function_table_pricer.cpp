@@ -0,0 +1,77 @@
+#include <array>
+
+#include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
+
+// The type tag indexes a hand-written table of pricing functions instead of a compiler vtable.
+// The virtual destructor is only there so the book can own instruments through Data pointers;
+// pricing never goes through it.
+class Data {
+public:
+    virtual ~Data() = default;
+    InstrumentKind kind() const { return tag; }
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    explicit Data(InstrumentKind k) : tag(k) {}
+    InstrumentKind tag;
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData() : Data(InstrumentKind::Stock), priceFactor(1.2) {}
+    double priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    explicit OptionData(const OptionContract& terms) : Data(InstrumentKind::Option), volatility(0.8), contract(terms) {}
+    double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class TablePricer {
+public:
+    double calculatePrice(const Data* data) const { return PRICE_TABLE[static_cast<size_t>(data->kind())](data); }
+
+private:
+    using PriceFunction = double (*)(const Data*);
+
+    static double priceStock(const Data* data) {
+        return static_cast<const StockData*>(data)->priceFactor * 1.1 + data->getCommonFactor();
+    }
+    static double priceOption(const Data* data) {
+        const auto* option = static_cast<const OptionData*>(data);
+        return optionPrice(option->volatility, data->getCommonFactor(), option->contract);
+    }
+
+    // Indexed by InstrumentKind.
+    static constexpr std::array<PriceFunction, 2> PRICE_TABLE = {&priceStock, &priceOption};
+};
+
+SPEEDFP_DESIGN(function_table_pricer) {
+    TablePricer pricer;
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+        }
+    }
+
+    benchmark("Design: Function table with Pricer", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(pricer.calculatePrice(data.get()));
+        }
+    }, ITERATIONS);
+
+    benchmarkScaling("Design: Function table with Pricer", dataSamples, [&](const auto& data) {
+        return pricer.calculatePrice(data.get());
+    });
+}
+
+} // namespace
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "black_scholes.h"
+
+// Black-Scholes price and sensitivities in one pass. Three ways to get them:
+//   blackScholesGreeks       - closed form; d1, d2, the discount factor and the density are shared
+//                              between price and every Greek.
+//   blackScholesGreeksBumped - central-difference bump-and-reprice that computes log(S/K), sqrt(T)
+//                              and the discount factor once and only re-evaluates the normal CDFs
+//                              for each bumped scenario.
+//   blackScholesGreeksNaive  - the same bumps as five independent full reprices, for comparison.
+// Theta is per year of calendar time, vega per unit of volatility.
+
+template <typename L>
+struct GreeksLanes {
+    L price;
+    L delta;
+    L gamma;
+    L vega;
+    L theta;
+};
+
+using Greeks = GreeksLanes<ScalarLane>;
+
+constexpr double SPOT_BUMP = 0.01;   // relative
+constexpr double VOL_BUMP = 0.01;    // absolute
+constexpr double TIME_BUMP = 1.0 / 365.0;  // one day, or half the remaining expiry if shorter
+
+template <typename L>
+inline GreeksLanes<L> blackScholesGreeks(L spot, L strike, L rate, L expiry, L volatility, L callPut) {
+    L sqrtT = L::sqrt(expiry);
+    L deviation = volatility * sqrtT;
+    L d1 = (vlog(spot / strike) + (rate + L::splat(0.5) * volatility * volatility) * expiry) / deviation;
+    L d2 = d1 - deviation;
+    L discountedStrike = strike * vexp(L::splat(0.0) - rate * expiry);
+    L density = vexp(L::splat(-0.5) * d1 * d1) * L::splat(INV_SQRT_2PI);
+    L n1 = vnormCdf(callPut * d1);
+    L n2 = vnormCdf(callPut * d2);
+
+    GreeksLanes<L> greeks;
+    greeks.price = callPut * (spot * n1 - discountedStrike * n2);
+    greeks.delta = callPut * n1;
+    greeks.gamma = density / (spot * deviation);
+    greeks.vega = spot * density * sqrtT;
+    greeks.theta = L::splat(0.0) - spot * density * volatility / (L::splat(2.0) * sqrtT) - callPut * rate * discountedStrike * n2;
+    return greeks;
+}
+
+template <typename L>
+inline GreeksLanes<L> blackScholesGreeksBumped(L spot, L strike, L rate, L expiry, L volatility, L callPut) {
+    L logMoneyness = vlog(spot / strike);
+    L sqrtT = L::sqrt(expiry);
+    L discount = vexp(L::splat(0.0) - rate * expiry);
+
+    // Reprice from shared intermediates; only the spot shift, volatility or expiry differ.
+    auto reprice = [&](L logShift, L spotScale, L vol, L t, L sqrtTime, L df) {
+        L deviation = vol * sqrtTime;
+        L d1 = (logMoneyness + logShift + (rate + L::splat(0.5) * vol * vol) * t) / deviation;
+        L d2 = d1 - deviation;
+        return callPut * (spot * spotScale * vnormCdf(callPut * d1) - strike * df * vnormCdf(callPut * d2));
+    };
+
+    const L zero = L::splat(0.0);
+    const L one = L::splat(1.0);
+    L timeBump = L::min(L::splat(TIME_BUMP), expiry * L::splat(0.5));  // never bump past expiry
+    L bumpedT = expiry - timeBump;
+    L base = reprice(zero, one, volatility, expiry, sqrtT, discount);
+    L up = reprice(L::splat(std::log1p(SPOT_BUMP)), L::splat(1.0 + SPOT_BUMP), volatility, expiry, sqrtT, discount);
+    L down = reprice(L::splat(std::log1p(-SPOT_BUMP)), L::splat(1.0 - SPOT_BUMP), volatility, expiry, sqrtT, discount);
+    L volUp = reprice(zero, one, volatility + L::splat(VOL_BUMP), expiry, sqrtT, discount);
+    L earlier = reprice(zero, one, volatility, bumpedT, L::sqrt(bumpedT), vexp(zero - rate * bumpedT));
+
+    L h = spot * L::splat(SPOT_BUMP);
+    GreeksLanes<L> greeks;
+    greeks.price = base;
+    greeks.delta = (up - down) / (L::splat(2.0) * h);
+    greeks.gamma = (up - L::splat(2.0) * base + down) / (h * h);
+    greeks.vega = (volUp - base) / L::splat(VOL_BUMP);
+    greeks.theta = (earlier - base) / timeBump;
+    return greeks;
+}
+
+template <typename L>
+inline GreeksLanes<L> blackScholesGreeksNaive(L spot, L strike, L rate, L expiry, L volatility, L callPut) {
+    L h = spot * L::splat(SPOT_BUMP);
+    L base = blackScholes(spot, strike, rate, expiry, volatility, callPut);
+    L up = blackScholes(spot + h, strike, rate, expiry, volatility, callPut);
+    L down = blackScholes(spot - h, strike, rate, expiry, volatility, callPut);
+    L volUp = blackScholes(spot, strike, rate, expiry, volatility + L::splat(VOL_BUMP), callPut);
+    L timeBump = L::min(L::splat(TIME_BUMP), expiry * L::splat(0.5));
+    L earlier = blackScholes(spot, strike, rate, expiry - timeBump, volatility, callPut);
+
+    GreeksLanes<L> greeks;
+    greeks.price = base;
+    greeks.delta = (up - down) / (L::splat(2.0) * h);
+    greeks.gamma = (up - L::splat(2.0) * base + down) / (h * h);
+    greeks.vega = (volUp - base) / L::splat(VOL_BUMP);
+    greeks.theta = (earlier - base) / timeBump;
+    return greeks;
+}
+
+enum class GreeksMethod { Analytic, Bumped, Naive };
+
+inline const char* greeksMethodName(GreeksMethod method) {
+    switch (method) {
+    case GreeksMethod::Bumped: return "shared bump-and-reprice";
+    case GreeksMethod::Naive: return "naive bump-and-reprice";
+    default: return "analytic";
+    }
+}
+
+template <typename L>
+inline GreeksLanes<L> blackScholesGreeks(GreeksMethod method, L spot, L strike, L rate, L expiry, L volatility, L callPut) {
+    if (method == GreeksMethod::Bumped) return blackScholesGreeksBumped(spot, strike, rate, expiry, volatility, callPut);
+    if (method == GreeksMethod::Naive) return blackScholesGreeksNaive(spot, strike, rate, expiry, volatility, callPut);
+    return blackScholesGreeks(spot, strike, rate, expiry, volatility, callPut);
+}
+
+inline Greeks blackScholesGreeks(GreeksMethod method, const OptionTerms& terms) {
+    return blackScholesGreeks(method, ScalarLane{terms.spot}, ScalarLane{terms.strike}, ScalarLane{terms.rate},
+                              ScalarLane{terms.expiry}, ScalarLane{terms.volatility},
+                              ScalarLane{terms.isCall ? 1.0 : -1.0});
+}
+
+// Output columns of a batch Greeks run, one entry per option.
+struct GreeksOutputs {
+    double* price;
+    double* delta;
+    double* gamma;
+    double* vega;
+    double* theta;
+};
+
+template <typename L>
+inline void priceGreeksLanes(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out) {
+    auto evaluate = [&](const double* const* columns, size_t offset, double* const* targets) {
+        auto greeks = blackScholesGreeks(method, L::load(columns[0] + offset), L::load(columns[1] + offset),
+                                         L::load(columns[2] + offset), L::load(columns[3] + offset),
+                                         L::load(columns[4] + offset), L::load(columns[5] + offset));
+        greeks.price.store(targets[0]);
+        greeks.delta.store(targets[1]);
+        greeks.gamma.store(targets[2]);
+        greeks.vega.store(targets[3]);
+        greeks.theta.store(targets[4]);
+    };
+
+    const double* columns[6] = {in.spot, in.strike, in.rate, in.expiry, in.volatility, in.callPut};
+    size_t i = 0;
+    for (; i + L::WIDTH <= in.size; i += L::WIDTH) {
+        double* targets[5] = {out.price + i, out.delta + i, out.gamma + i, out.vega + i, out.theta + i};
+        evaluate(columns, i, targets);
+    }
+    if (i == in.size) return;
+
+    // Pad the tail with a harmless option, as priceBlackScholesLanes does.
+    double tail[6][L::WIDTH];
+    double results[5][L::WIDTH];
+    const double padding[6] = {1.0, 1.0, 0.0, 1.0, 0.2, 1.0};
+    const double* tailColumns[6];
+    double* tailTargets[5];
+    for (size_t c = 0; c < 6; ++c) {
+        for (size_t lane = 0; lane < L::WIDTH; ++lane) {
+            tail[c][lane] = i + lane < in.size ? columns[c][i + lane] : padding[c];
+        }
+        tailColumns[c] = tail[c];
+    }
+    for (size_t g = 0; g < 5; ++g) tailTargets[g] = results[g];
+    evaluate(tailColumns, 0, tailTargets);
+
+    double* targets[5] = {out.price, out.delta, out.gamma, out.vega, out.theta};
+    for (size_t g = 0; g < 5; ++g) {
+        for (size_t lane = 0; i + lane < in.size; ++lane) targets[g][i + lane] = results[g][lane];
+    }
+}
+
+// Defined next to the Black-Scholes batch kernels, one per instruction set.
+void priceGreeksScalar(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out);
+void priceGreeksAvx2(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out);
+void priceGreeksAvx512(GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out);
+
+inline void priceGreeks(SimdLevel level, GreeksMethod method, const BlackScholesInputs& in, const GreeksOutputs& out) {
+    if (level == SimdLevel::Avx512) return priceGreeksAvx512(method, in, out);
+    if (level == SimdLevel::Avx2) return priceGreeksAvx2(method, in, out);
+    priceGreeksScalar(method, in, out);
+}
@@ -0,0 +1,101 @@
+#include "benchmark.h"
+#include "greeks.h"
+
+namespace {
+
+class StockPricer;
+class OptionPricer;
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual Greeks calculateGreeks(GreeksMethod method) const = 0;
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData(StockPricer* p) : pricer(p), priceFactor(1.2) {}
+    Greeks calculateGreeks(GreeksMethod method) const override;
+    StockPricer* pricer;
+    double priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    OptionData(OptionPricer* p, const OptionTerms& t) : pricer(p), terms(t) {}
+    Greeks calculateGreeks(GreeksMethod method) const override;
+    OptionPricer* pricer;
+    OptionTerms terms;
+};
+
+// Sensitivities of a stock are to its price factor: linear, so only delta is non-zero.
+class StockPricer {
+public:
+    Greeks calculateGreeks(const StockData& data) const {
+        return {{data.priceFactor * 1.1 + data.getCommonFactor()}, {1.1}, {0.0}, {0.0}, {0.0}};
+    }
+};
+
+class OptionPricer {
+public:
+    Greeks calculateGreeks(const OptionData& data, GreeksMethod method) const {
+        return blackScholesGreeks(method, data.terms);
+    }
+};
+
+Greeks StockData::calculateGreeks(GreeksMethod) const { return pricer->calculateGreeks(*this); }
+Greeks OptionData::calculateGreeks(GreeksMethod method) const { return pricer->calculateGreeks(*this, method); }
+
+void reportGreeksRate(const BenchmarkResult& result) {
+    if (benchmarkOptions().format != OutputFormat::Text) return;
+    std::cout << "    " << 1e3 / result.median << " M instruments/s with price, delta, gamma, vega and theta\n";
+}
+
+SPEEDFP_DESIGN(greeks_pricer) {
+    StockPricer stockPricer;
+    OptionPricer optionPricer;
+
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    BlackScholesColumns options;
+    auto types = workloadTypes();
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (types[i] == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer));
+        } else {
+            OptionTerms terms = sampleOptionTerms(i);
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, terms));
+            options.add(terms);
+        }
+    }
+
+    for (GreeksMethod method : {GreeksMethod::Analytic, GreeksMethod::Bumped, GreeksMethod::Naive}) {
+        auto result = benchmark(std::string("Design: Virtual function Greeks, ") + greeksMethodName(method), [&]() {
+            for (const auto& data : dataSamples) {
+                Greeks greeks = data->calculateGreeks(method);
+                doNotOptimize(greeks);
+            }
+        }, ITERATIONS);
+        reportGreeksRate(result);
+    }
+
+    // Stocks have constant sensitivities, so the batch runs cover the options only.
+    std::vector<AlignedVector<double>> columns(5, AlignedVector<double>(options.size()));
+    GreeksOutputs outputs{columns[0].data(), columns[1].data(), columns[2].data(), columns[3].data(), columns[4].data()};
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (!simdLevelSupported(level)) continue;
+        for (GreeksMethod method : {GreeksMethod::Analytic, GreeksMethod::Bumped}) {
+            std::string label = std::string("Design: SoA batch Greeks, ") + greeksMethodName(method) + ", " +
+                                simdLevelName(level) + " kernel";
+            auto result = benchmark(label, [&]() {
+                priceGreeks(level, method, options.inputs(), outputs);
+                clobberMemory();
+            }, ITERATIONS, options.size());
+            reportGreeksRate(result);
+        }
+    }
+}
+
+} // namespace
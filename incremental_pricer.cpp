@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+#include "benchmark.h"
+#include "dependency_graph.h"
+
+namespace {
+
+constexpr size_t SECTOR_SIZE = 64;  // instruments sharing one commonFactor input
+constexpr double UPDATE_RATES[] = {0.001, 0.01, 0.1, 0.25, 1.0};
+
+// Same prices as virtual_function, but every factor is a subscribed market input rather than a
+// per-object constant.
+class Data {
+public:
+    explicit Data(size_t common) : commonFactor(common) {}
+    virtual ~Data() = default;
+    virtual double calculatePrice(const MarketGraph& market) const = 0;
+    virtual size_t ownInput() const = 0;
+    double getCommonFactor(const MarketGraph& market) const { return market.value(commonFactor); }
+protected:
+    size_t commonFactor;
+};
+
+class StockData : public Data {
+public:
+    StockData(size_t common, size_t price) : Data(common), priceFactor(price) {}
+    double calculatePrice(const MarketGraph& market) const override {
+        return market.value(priceFactor) * 1.1 + getCommonFactor(market);
+    }
+    size_t ownInput() const override { return priceFactor; }
+private:
+    size_t priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    OptionData(size_t common, size_t vol, const OptionContract& terms) : Data(common), volatility(vol), contract(terms) {}
+    double calculatePrice(const MarketGraph& market) const override {
+        return optionPrice(market.value(volatility), getCommonFactor(market), contract);
+    }
+    size_t ownInput() const override { return volatility; }
+private:
+    size_t volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+SPEEDFP_DESIGN(incremental_pricer) {
+    MarketGraph market;
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    std::vector<size_t> sectors;
+    auto types = workloadTypes();
+    size_t options = 0;
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (i % SECTOR_SIZE == 0) sectors.push_back(market.addInput(0.5));
+        size_t common = sectors.back();
+        size_t own = market.addInput(types[i] == InstrumentKind::Stock ? 1.2 : 0.8);
+        if (types[i] == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(common, own));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(common, own, optionContract(options++)));
+        }
+        market.subscribe(i, common);
+        market.subscribe(i, own);
+    }
+    market.build();
+
+    std::vector<double> prices(dataSamples.size());
+    market.markAllDirty();
+    market.reprice([&](size_t i) { prices[i] = dataSamples[i]->calculatePrice(market); });
+
+    // Each pass bumps a fixed set of inputs, then reprices either everything or just their dependents.
+    size_t pass = 0;
+    auto measure = [&](const std::string& label, const std::vector<size_t>& updated) {
+        auto full = benchmark(label + "full reprice", [&]() {
+            double bump = (++pass & 1) ? 0.01 : -0.01;
+            for (size_t input : updated) market.set(input, market.value(input) + bump);
+            for (size_t i = 0; i < dataSamples.size(); ++i) {
+                prices[i] = dataSamples[i]->calculatePrice(market);
+            }
+            clobberMemory();
+        }, ITERATIONS);
+
+        size_t repriced = 0;
+        auto incremental = benchmark(label + "incremental reprice", [&]() {
+            double bump = (++pass & 1) ? 0.01 : -0.01;
+            for (size_t input : updated) market.update(input, market.value(input) + bump);
+            repriced = market.reprice([&](size_t i) { prices[i] = dataSamples[i]->calculatePrice(market); });
+            clobberMemory();
+        }, ITERATIONS);
+
+        if (benchmarkOptions().format != OutputFormat::Text) return;
+        std::cout << "    " << repriced << " of " << dataSamples.size() << " instruments repriced per pass, "
+                  << full.median / incremental.median << "x faster than a full reprice\n";
+    };
+
+    // Own-input updates: each input has a single dependent, bumped for a fixed random subset of the book.
+    std::vector<size_t> order(dataSamples.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::mt19937_64 rng(benchmarkOptions().seed);
+    shuffleSequence(order, rng);
+
+    for (double rate : UPDATE_RATES) {
+        size_t count = std::max<size_t>(1, static_cast<size_t>(rate * dataSamples.size()));
+        std::vector<size_t> updated;
+        for (size_t k = 0; k < count; ++k) updated.push_back(dataSamples[order[k]]->ownInput());
+        std::sort(updated.begin(), updated.end());
+
+        std::ostringstream label;
+        label << "Design: Market updates to " << rate * 100 << "% of the book, ";
+        measure(label.str(), updated);
+    }
+
+    // Sector updates: each commonFactor input fans out to SECTOR_SIZE instruments.
+    std::vector<size_t> sectorOrder = sectors;
+    shuffleSequence(sectorOrder, rng);
+
+    for (double rate : UPDATE_RATES) {
+        size_t count = std::max<size_t>(1, static_cast<size_t>(rate * sectors.size()));
+        std::vector<size_t> updated(sectorOrder.begin(), sectorOrder.begin() + count);
+        std::sort(updated.begin(), updated.end());
+
+        std::ostringstream label;
+        label << "Design: Sector updates to " << rate * 100 << "% of the sectors, ";
+        measure(label.str(), updated);
+    }
+}
+
+} // namespace
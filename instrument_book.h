@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// Columnar (structure-of-arrays) storage: one contiguous, cache-line aligned array per field and
+// instrument type, so a whole column can be priced with SIMD instead of dispatching per object.
+
+constexpr size_t COLUMN_ALIGNMENT = 64;
+
+template <typename T>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{COLUMN_ALIGNMENT}));
+    }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t{COLUMN_ALIGNMENT}); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const { return true; }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+struct StockColumns {
+    AlignedVector<double> priceFactor;
+    AlignedVector<double> commonFactor;
+};
+
+// An option's contract terms besides its volatility. Only the Black-Scholes option model
+// (option_model.h) reads them, so in the default model the struct and its columns are empty and
+// every book keeps its original layout. The defaults are an at-the-money one-year call.
+struct OptionContract {
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    double spot = 100.0;
+    double strike = 100.0;
+    double rate = 0.03;
+    double expiry = 1.0;   // in years
+    double callPut = 1.0;  // +1 for a call, -1 for a put
+#endif
+};
+
+struct OptionColumns {
+    AlignedVector<double> volatility;
+    AlignedVector<double> commonFactor;
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    AlignedVector<double> spot;
+    AlignedVector<double> strike;
+    AlignedVector<double> rate;
+    AlignedVector<double> expiry;
+    AlignedVector<double> callPut;
+#endif
+
+    OptionContract contract(size_t row) const {
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+        return {spot[row], strike[row], rate[row], expiry[row], callPut[row]};
+#else
+        (void)row;
+        return {};
+#endif
+    }
+};
+
+class InstrumentBook {
+public:
+    void addStock(double priceFactor, double commonFactor = 0.5) {
+        stocks.priceFactor.push_back(priceFactor);
+        stocks.commonFactor.push_back(commonFactor);
+    }
+
+    void addOption(double volatility, double commonFactor = 0.5, const OptionContract& contract = {}) {
+        options.volatility.push_back(volatility);
+        options.commonFactor.push_back(commonFactor);
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+        options.spot.push_back(contract.spot);
+        options.strike.push_back(contract.strike);
+        options.rate.push_back(contract.rate);
+        options.expiry.push_back(contract.expiry);
+        options.callPut.push_back(contract.callPut);
+#else
+        (void)contract;
+#endif
+    }
+
+    size_t size() const { return stocks.priceFactor.size() + options.volatility.size(); }
+
+    StockColumns stocks;
+    OptionColumns options;
+};
+
+// The pricing formulas shared by every design: stock = priceFactor * 1.1 + commonFactor and
+// option = volatility * 2.5 + commonFactor, i.e. out[i] = factor[i] * scale + common[i].
+constexpr double STOCK_SCALE = 1.1;
+constexpr double OPTION_SCALE = 2.5;
+
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Avx2: return "AVX2";
+    case SimdLevel::Avx512: return "AVX-512";
+    default: return "scalar";
+    }
+}
+
+// Runtime CPU check guarding the *_avx2.cpp / *_avx512.cpp kernels. MSVC has no
+// __builtin_cpu_supports, so it reads CPUID and confirms with XGETBV that the OS saves the wider
+// registers.
+inline bool simdLevelSupported(SimdLevel level) {
+    if (level == SimdLevel::Scalar) return true;
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    if (level == SimdLevel::Avx2) return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && defined(_M_X64)
+    int info[4];
+    __cpuid(info, 1);
+    bool osSaves = (info[2] & (1 << 27)) != 0;
+    bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osSaves) return false;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (level == SimdLevel::Avx2) return fma && (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+    return (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+#else
+    return false;
+#endif
+}
+
+// The widest kernel this CPU can run, for code that just wants the fast path.
+inline SimdLevel widestSimdLevel() {
+    for (SimdLevel level : {SimdLevel::Avx512, SimdLevel::Avx2}) {
+        if (simdLevelSupported(level)) return level;
+    }
+    return SimdLevel::Scalar;
+}
+
+inline void priceColumnScalar(const double* factor, const double* common, double scale, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = factor[i] * scale + common[i];
+    }
+}
+
+// Defined in instrument_book_avx2.cpp and instrument_book_avx512.cpp, each compiled for its
+// instruction set; they fall back to the scalar kernel when built for a target without it.
+void priceColumnAvx2(const double* factor, const double* common, double scale, double* out, size_t n);
+void priceColumnAvx512(const double* factor, const double* common, double scale, double* out, size_t n);
+
+inline void priceColumn(SimdLevel level, const double* factor, const double* common, double scale, double* out,
+                        size_t n) {
+    if (level == SimdLevel::Avx512) return priceColumnAvx512(factor, common, scale, out, n);
+    if (level == SimdLevel::Avx2) return priceColumnAvx2(factor, common, scale, out, n);
+    priceColumnScalar(factor, common, scale, out, n);
+}
@@ -0,0 +1,23 @@
+// Compiled with AVX2 and FMA enabled; only reached when the CPU supports them.
+#include "instrument_book.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+void priceColumnAvx2(const double* factor, const double* common, double scale, double* out, size_t n) {
+#ifdef __AVX2__
+    const __m256d s = _mm256_set1_pd(scale);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d f = _mm256_load_pd(factor + i);
+        __m256d c = _mm256_load_pd(common + i);
+        _mm256_store_pd(out + i, _mm256_fmadd_pd(f, s, c));
+    }
+    for (; i < n; ++i) {
+        out[i] = factor[i] * scale + common[i];
+    }
+#else
+    priceColumnScalar(factor, common, scale, out, n);
+#endif
+}
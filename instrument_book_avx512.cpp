@@ -0,0 +1,26 @@
+// Compiled with AVX-512F enabled; only reached when the CPU supports it.
+#include "instrument_book.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+void priceColumnAvx512(const double* factor, const double* common, double scale, double* out, size_t n) {
+#ifdef __AVX512F__
+    const __m512d s = _mm512_set1_pd(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d f = _mm512_load_pd(factor + i);
+        __m512d c = _mm512_load_pd(common + i);
+        _mm512_store_pd(out + i, _mm512_fmadd_pd(f, s, c));
+    }
+    if (i < n) {
+        __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d f = _mm512_maskz_loadu_pd(tail, factor + i);
+        __m512d c = _mm512_maskz_loadu_pd(tail, common + i);
+        _mm512_mask_storeu_pd(out + i, tail, _mm512_fmadd_pd(f, s, c));
+    }
+#else
+    priceColumnScalar(factor, common, scale, out, n);
+#endif
+}
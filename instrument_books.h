@@ -0,0 +1,308 @@
+#pragma once
+
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+#include "benchmark.h"
+#include "instrument_book.h"
+#include "tick_pipeline.h"
+
+// Books addressed by instrument id, for the designs that price one instrument at a time as ticks or
+// requests arrive rather than sweeping the whole book. Each book is callable as
+// double(uint32_t) const, pricing one instrument, and as double(const TickRecord&), applying the
+// tick and returning the instrument's new price. Pricing is read-only, so one book can be shared
+// by several threads. The classes live in namespace books so that they do not collide with the
+// designs' own Data, StockData and OptionData.
+
+namespace books {
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+    virtual void setFactor(double value) = 0;
+    double getCommonFactor() const { return commonFactor; }
+    void setCommonFactor(double value) { commonFactor = value; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    double calculatePrice() const override { return priceFactor * STOCK_SCALE + getCommonFactor(); }
+    void setFactor(double value) override { priceFactor = value; }
+    double getPriceFactor() const { return priceFactor; }
+private:
+    double priceFactor = 1.2;
+};
+
+class OptionData : public Data {
+public:
+    explicit OptionData(const OptionContract& terms) : contract(terms) {}
+    double calculatePrice() const override { return optionPrice(volatility, getCommonFactor(), contract); }
+    void setFactor(double value) override { volatility = value; }
+    double getVolatility() const { return volatility; }
+    const OptionContract& getContract() const { return contract; }
+private:
+    double volatility = 0.8;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+inline void applyTick(Data& data, const TickRecord& tick) {
+    if (tick.field == TickField::CommonFactor) {
+        data.setCommonFactor(tick.value);
+    } else {
+        data.setFactor(tick.value);
+    }
+}
+
+class VirtualBook {
+public:
+    explicit VirtualBook(const std::vector<InstrumentKind>& kinds) {
+        size_t options = 0;
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(makeInstrument<StockData>());
+            } else {
+                book.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const { return book[instrument]->calculatePrice(); }
+
+    double operator()(const TickRecord& tick) {
+        Data& data = *book[tick.instrument];
+        applyTick(data, tick);
+        return data.calculatePrice();
+    }
+
+    const std::vector<InstrumentPtr<Data>>& instruments() const { return book; }
+
+private:
+    std::vector<InstrumentPtr<Data>> book;
+};
+
+// The plug-in shape: each instrument names a per-type Pricer object, and the pricer downcasts.
+class Pricer {
+public:
+    virtual ~Pricer() = default;
+    virtual double calculatePrice(const Data& data) const = 0;
+};
+
+class StockPricer : public Pricer {
+public:
+    double calculatePrice(const Data& data) const override {
+        const auto& stock = static_cast<const StockData&>(data);
+        return stock.getPriceFactor() * STOCK_SCALE + stock.getCommonFactor();
+    }
+};
+
+class OptionPricer : public Pricer {
+public:
+    double calculatePrice(const Data& data) const override {
+        const auto& option = static_cast<const OptionData&>(data);
+        return optionPrice(option.getVolatility(), option.getCommonFactor(), option.getContract());
+    }
+};
+
+class PluginBook {
+public:
+    explicit PluginBook(const std::vector<InstrumentKind>& kinds) {
+        size_t options = 0;
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                book.push_back({makeInstrument<StockData>(), &stockPricer});
+            } else {
+                book.push_back({makeInstrument<OptionData>(optionContract(options++)), &optionPricer});
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const {
+        const Entry& entry = book[instrument];
+        return entry.pricer->calculatePrice(*entry.data);
+    }
+
+    double operator()(const TickRecord& tick) {
+        Entry& entry = book[tick.instrument];
+        applyTick(*entry.data, tick);
+        return entry.pricer->calculatePrice(*entry.data);
+    }
+
+private:
+    struct Entry {
+        InstrumentPtr<Data> data;
+        const Pricer* pricer;
+    };
+
+    StockPricer stockPricer;
+    OptionPricer optionPricer;
+    std::vector<Entry> book;
+};
+
+// The dynamic_cast shape: the book holds the base class and finds the concrete type per call.
+class DynamicCastBook {
+public:
+    explicit DynamicCastBook(const std::vector<InstrumentKind>& kinds) {
+        size_t options = 0;
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(makeInstrument<StockData>());
+            } else {
+                book.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const { return price(*book[instrument]); }
+
+    double operator()(const TickRecord& tick) {
+        Data& data = *book[tick.instrument];
+        applyTick(data, tick);
+        return price(data);
+    }
+
+private:
+    static double price(const Data& data) {
+        if (const auto* stock = dynamic_cast<const StockData*>(&data)) {
+            return stock->getPriceFactor() * STOCK_SCALE + stock->getCommonFactor();
+        }
+        const auto& option = dynamic_cast<const OptionData&>(data);
+        return optionPrice(option.getVolatility(), option.getCommonFactor(), option.getContract());
+    }
+
+    std::vector<InstrumentPtr<Data>> book;
+};
+
+struct StockValue {
+    double factor = 1.2;
+    double commonFactor = 0.5;
+    double calculatePrice() const { return factor * STOCK_SCALE + commonFactor; }
+};
+
+struct OptionValue {
+    double factor = 0.8;
+    double commonFactor = 0.5;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+    double calculatePrice() const { return optionPrice(factor, commonFactor, contract); }
+};
+
+class VariantBook {
+public:
+    explicit VariantBook(const std::vector<InstrumentKind>& kinds) {
+        size_t options = 0;
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(StockValue{});
+            } else {
+                book.emplace_back(OptionValue{.contract = optionContract(options++)});
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, book[instrument]);
+    }
+
+    double operator()(const TickRecord& tick) {
+        return std::visit([&](auto& data) {
+            (tick.field == TickField::CommonFactor ? data.commonFactor : data.factor) = tick.value;
+            return data.calculatePrice();
+        }, book[tick.instrument]);
+    }
+
+private:
+    std::vector<std::variant<StockValue, OptionValue>> book;
+};
+
+// The CRTP shape: the base forwards calculatePrice() to the derived type at compile time, and a
+// std::variant holds the two types by value.
+template <typename Derived>
+struct CrtpData {
+    double factor;
+    double commonFactor = 0.5;
+    double calculatePrice() const { return static_cast<const Derived*>(this)->calculatePriceImpl(); }
+};
+
+struct CrtpStock : CrtpData<CrtpStock> {
+    CrtpStock() { factor = 1.2; }
+    double calculatePriceImpl() const { return factor * STOCK_SCALE + commonFactor; }
+};
+
+struct CrtpOption : CrtpData<CrtpOption> {
+    explicit CrtpOption(const OptionContract& terms) : contract(terms) { factor = 0.8; }
+    double calculatePriceImpl() const { return optionPrice(factor, commonFactor, contract); }
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class CrtpBook {
+public:
+    explicit CrtpBook(const std::vector<InstrumentKind>& kinds) {
+        size_t options = 0;
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(CrtpStock{});
+            } else {
+                book.emplace_back(CrtpOption(optionContract(options++)));
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const {
+        return std::visit([](const auto& data) { return data.calculatePrice(); }, book[instrument]);
+    }
+
+    double operator()(const TickRecord& tick) {
+        return std::visit([&](auto& data) {
+            (tick.field == TickField::CommonFactor ? data.commonFactor : data.factor) = tick.value;
+            return data.calculatePrice();
+        }, book[tick.instrument]);
+    }
+
+private:
+    std::vector<std::variant<CrtpStock, CrtpOption>> book;
+};
+
+// Lookups arrive by instrument id, so the SoA book keeps each instrument's type and column row.
+class SoaBook {
+public:
+    explicit SoaBook(const std::vector<InstrumentKind>& kinds) : types(kinds) {
+        for (auto kind : kinds) {
+            if (kind == InstrumentKind::Stock) {
+                rows.push_back(static_cast<uint32_t>(book.stocks.priceFactor.size()));
+                book.addStock(1.2);
+            } else {
+                size_t row = book.options.volatility.size();
+                rows.push_back(static_cast<uint32_t>(row));
+                book.addOption(0.8, 0.5, optionContract(row));
+            }
+        }
+    }
+
+    double operator()(uint32_t instrument) const {
+        uint32_t row = rows[instrument];
+        if (types[instrument] == InstrumentKind::Stock) {
+            return book.stocks.priceFactor[row] * STOCK_SCALE + book.stocks.commonFactor[row];
+        }
+        return optionPrice(book.options.volatility[row], book.options.commonFactor[row], book.options.contract(row));
+    }
+
+    double operator()(const TickRecord& tick) {
+        uint32_t row = rows[tick.instrument];
+        bool stock = types[tick.instrument] == InstrumentKind::Stock;
+        double* factor = stock ? book.stocks.priceFactor.data() : book.options.volatility.data();
+        double* common = stock ? book.stocks.commonFactor.data() : book.options.commonFactor.data();
+        (tick.field == TickField::CommonFactor ? common : factor)[row] = tick.value;
+        if (stock) return factor[row] * STOCK_SCALE + common[row];
+        return optionPrice(factor[row], common[row], book.options.contract(row));
+    }
+
+private:
+    InstrumentBook book;
+    std::vector<InstrumentKind> types;
+    std::vector<uint32_t> rows;
+};
+
+} // namespace books
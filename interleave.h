@@ -0,0 +1,110 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Memory-level parallelism for pointer-chasing loops. A plain loop over heap objects waits on each
+// object's cache miss before it can even find the next; prefetchRead() starts a load early, and
+// runInterleaved() round-robins coroutines that each prefetch their next object and suspend, so
+// several misses are in flight while the others compute.
+
+inline void prefetchRead(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
+
+// A coroutine that starts suspended and is driven by runInterleaved(); its body suspends with
+// `co_await std::suspend_always{}` right after prefetching what it needs next.
+class InterleavedTask {
+public:
+    struct promise_type {
+        InterleavedTask get_return_object() {
+            return InterleavedTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    InterleavedTask(InterleavedTask&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    InterleavedTask& operator=(InterleavedTask&&) = delete;
+    ~InterleavedTask() {
+        if (handle) handle.destroy();
+    }
+
+    bool done() const { return handle.done(); }
+    void resume() { handle.resume(); }
+
+private:
+    explicit InterleavedTask(std::coroutine_handle<promise_type> h) : handle(h) {}
+    std::coroutine_handle<promise_type> handle;
+};
+
+// Resumes the tasks in turn until all of them have finished.
+inline void runInterleaved(std::vector<InterleavedTask>& tasks) {
+    size_t live = tasks.size();
+    while (live > 0) {
+        for (auto& task : tasks) {
+            if (task.done()) continue;
+            task.resume();
+            if (task.done()) --live;
+        }
+    }
+}
+
+// The pricing loops over a book of pointers to heap objects with calculatePrice() - a
+// std::vector<InstrumentPtr<T>> of any of the pointer-based designs.
+
+template <typename Book>
+double pricePlain(const Book& book) {
+    double total = 0;
+    for (const auto& data : book) total += data->calculatePrice();
+    return total;
+}
+
+// The object of instrument i + distance is requested while instrument i is priced; the pointer
+// array itself is sequential and left to the hardware prefetcher.
+template <typename Book>
+double pricePrefetched(const Book& book, size_t distance) {
+    double total = 0;
+    size_t n = book.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (i + distance < n) prefetchRead(book[i + distance].get());
+        total += book[i]->calculatePrice();
+    }
+    return total;
+}
+
+// Prices instruments first, first + stride, ...: prefetches each object, then yields to the other
+// tasks so their loads overlap with this one's.
+template <typename Book>
+InterleavedTask priceSlice(const Book& book, size_t first, size_t stride, double& total) {
+    for (size_t i = first; i < book.size(); i += stride) {
+        const auto* data = book[i].get();
+        prefetchRead(data);
+        co_await std::suspend_always{};
+        total += data->calculatePrice();
+    }
+}
+
+template <typename Book>
+double priceInterleaved(const Book& book, size_t group) {
+    double total = 0;
+    std::vector<InterleavedTask> tasks;
+    tasks.reserve(group);
+    for (size_t g = 0; g < group; ++g) tasks.push_back(priceSlice(book, g, group, total));
+    runInterleaved(tasks);
+    return total;
+}
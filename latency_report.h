@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+// Reporting for the open-loop designs (tick_pipeline_pricer, service_pricer), which measure one
+// latency per event rather than ns per item of a timed loop.
+
+// "250K ticks/s"; rate 0 is the unthrottled run, named `unthrottled`.
+inline std::string rateName(size_t rate, const std::string& unit, const std::string& unthrottled) {
+    if (rate == 0) return unthrottled;
+    if (rate % 1'000'000 == 0) return std::to_string(rate / 1'000'000) + "M " + unit;
+    if (rate % 1'000 == 0) return std::to_string(rate / 1'000) + "K " + unit;
+    return std::to_string(rate) + " " + unit;
+}
+
+// Records one open-loop run (a TickRun or ServiceRun) like a benchmark result with one sample per
+// event, in ns of `latency` (e.g. "tick-to-price"), so the JSON and CSV reports carry the
+// distribution too. `throughput` names the events/s figure of the text report.
+template <typename Run>
+void reportLatencyRun(const std::string& label, const Run& run, const std::string& latency,
+                      const std::string& throughput) {
+    BenchmarkResult result = newResult(label, bookSize());
+    result.samples = run.latencies;
+    summarize(result);
+    benchmarkResults().push_back(result);
+    doNotOptimize(run.checksum);
+    if (benchmarkOptions().format != OutputFormat::Text) return;
+
+    std::vector<double> sorted = run.latencies;
+    std::sort(sorted.begin(), sorted.end());
+    std::cout << label << " [" << result.workload << ", " << result.bookSize << " items] - " << latency << " p50 "
+              << percentile(sorted, 0.5) << " ns, p99 " << percentile(sorted, 0.99) << " ns, p99.9 "
+              << percentile(sorted, 0.999) << " ns, max " << sorted.back() << " ns ("
+              << static_cast<double>(run.latencies.size()) / run.seconds / 1e6 << " M " << throughput << ")\n";
+}
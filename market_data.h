@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "instrument_book.h"
+
+// Shared market state (rates, FX fixes, curve points) that instruments reference by handle instead
+// of embedding a copy. The store is double-buffered for one writer and any number of readers:
+//   - readers open a MarketView, which pins the published buffer and sees it unchanged until the
+//     view is destroyed; opening one costs two atomic increments and a load, with no locks;
+//   - the writer stages set() calls and publish() makes them visible all at once. It writes the
+//     back buffer once its readers have left, then flips the published index and bumps the epoch.
+// The back buffer is one publish behind, so publish() replays the previous batch before the new
+// one and costs O(changed inputs), not O(store size).
+
+struct MarketHandle {
+    uint32_t index;
+};
+
+class MarketDataStore;
+
+class MarketView {
+public:
+    MarketView(const MarketView&) = delete;
+    MarketView& operator=(const MarketView&) = delete;
+    ~MarketView();
+
+    double operator[](MarketHandle handle) const { return values[handle.index]; }
+    uint64_t epoch() const { return viewEpoch; }
+
+private:
+    friend class MarketDataStore;
+    MarketView(MarketDataStore& s, size_t b, const double* v, uint64_t e)
+        : store(s), buffer(b), values(v), viewEpoch(e) {}
+
+    MarketDataStore& store;
+    size_t buffer;
+    const double* values;
+    uint64_t viewEpoch;
+};
+
+class MarketDataStore {
+public:
+    // Setup only: not safe while readers or the writer are active.
+    MarketHandle add(double value) {
+        buffers[0].push_back(value);
+        buffers[1].push_back(value);
+        return {static_cast<uint32_t>(buffers[0].size() - 1)};
+    }
+
+    size_t size() const { return buffers[0].size(); }
+
+    // Writer side.
+    void set(MarketHandle handle, double value) { staged.emplace_back(handle.index, value); }
+
+    void publish() {
+        uint64_t state = published.load();
+        size_t front = state & 1;
+        size_t back = front ^ 1;
+        while (readers[back].count.load() != 0) std::this_thread::yield();
+
+        for (uint32_t index : lastBatch) buffers[back][index] = buffers[front][index];
+        lastBatch.clear();
+        for (const auto& [index, value] : staged) {
+            buffers[back][index] = value;
+            lastBatch.push_back(index);
+        }
+        staged.clear();
+        published.store(((state >> 1) + 1) << 1 | back);
+    }
+
+    // Reader side. Retries if a publish flips the buffers between pinning and confirming.
+    MarketView read() {
+        for (;;) {
+            uint64_t state = published.load();
+            size_t buffer = state & 1;
+            readers[buffer].count.fetch_add(1);
+            if (published.load() == state) return MarketView(*this, buffer, buffers[buffer].data(), state >> 1);
+            readers[buffer].count.fetch_sub(1);
+        }
+    }
+
+private:
+    friend class MarketView;
+
+    struct alignas(COLUMN_ALIGNMENT) ReaderCount {
+        std::atomic<uint32_t> count{0};
+    };
+
+    std::vector<double> buffers[2];
+    ReaderCount readers[2];
+    std::atomic<uint64_t> published{0};  // epoch << 1 | published buffer
+    std::vector<std::pair<uint32_t, double>> staged;
+    std::vector<uint32_t> lastBatch;
+};
+
+inline MarketView::~MarketView() { store.readers[buffer].count.fetch_sub(1); }
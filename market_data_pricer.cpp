@@ -0,0 +1,161 @@
+#include <thread>
+
+#include "benchmark.h"
+#include "market_data.h"
+
+namespace {
+
+constexpr size_t MARKET_INPUTS = 16;  // instrument i reads input i % MARKET_INPUTS
+// One pass is a single market update, so a SAMPLE_SIZE-update run is one iteration.
+constexpr size_t UPDATE_ITERATIONS = 1;
+constexpr size_t CONSISTENCY_READS = 100'000;
+constexpr size_t CONSISTENCY_PUBLISHES = 10'000;
+
+// The current layout: every object carries its own copy of the shared value.
+class EmbeddedData {
+public:
+    virtual ~EmbeddedData() = default;
+    virtual double calculatePrice() const = 0;
+    double getCommonFactor() const { return commonFactor; }
+    void setCommonFactor(double value) { commonFactor = value; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class EmbeddedStockData : public EmbeddedData {
+public:
+    EmbeddedStockData() : priceFactor(1.2) {}
+    double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
+private:
+    double priceFactor;
+};
+
+class EmbeddedOptionData : public EmbeddedData {
+public:
+    explicit EmbeddedOptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
+    double calculatePrice() const override { return optionPrice(volatility, getCommonFactor(), contract); }
+private:
+    double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+// The shared layout: objects drop commonFactor altogether and price against a consistent view of
+// the store. Each one's handle sits in a column beside the book, since a 4-byte handle inside the
+// object would be padded to 8 and leave it as large as the embedded one.
+class HandleData {
+public:
+    virtual ~HandleData() = default;
+    virtual double calculatePrice(double commonFactor) const = 0;
+};
+
+class HandleStockData : public HandleData {
+public:
+    HandleStockData() : priceFactor(1.2) {}
+    double calculatePrice(double commonFactor) const override { return priceFactor * 1.1 + commonFactor; }
+private:
+    double priceFactor;
+};
+
+class HandleOptionData : public HandleData {
+public:
+    explicit HandleOptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
+    double calculatePrice(double commonFactor) const override {
+        return optionPrice(volatility, commonFactor, contract);
+    }
+private:
+    double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+static_assert(sizeof(HandleStockData) < sizeof(EmbeddedStockData), "the handle layout must shrink the objects");
+
+// A writer thread republishes every input with one value per epoch while this thread reads; a
+// view mixing two epochs would be torn.
+void checkConsistency(MarketDataStore& store, const std::vector<MarketHandle>& handles) {
+    for (MarketHandle handle : handles) store.set(handle, 0.5);
+    store.publish();
+
+    std::atomic<bool> done{false};
+    std::atomic<size_t> publishes{0};
+    std::thread writer([&] {
+        while (!done.load()) {
+            double value = 0.5 + 1e-9 * static_cast<double>(publishes.load() + 1);
+            for (MarketHandle handle : handles) store.set(handle, value);
+            store.publish();
+            publishes.fetch_add(1);
+        }
+    });
+
+    size_t reads = 0, torn = 0;
+    while (reads < CONSISTENCY_READS || publishes.load() < CONSISTENCY_PUBLISHES) {
+        MarketView view = store.read();
+        for (MarketHandle handle : handles) torn += view[handle] != view[handles.front()];
+        ++reads;
+    }
+    done.store(true);
+    writer.join();
+
+    std::cout << "    " << reads << " views read across " << publishes.load() << " concurrent publishes, " << torn
+              << " torn values\n";
+}
+
+SPEEDFP_DESIGN(market_data_pricer) {
+    MarketDataStore store;
+    std::vector<MarketHandle> handles;
+    for (size_t input = 0; input < MARKET_INPUTS; ++input) handles.push_back(store.add(0.5));
+
+    std::vector<InstrumentPtr<EmbeddedData>> embedded;
+    std::vector<InstrumentPtr<HandleData>> shared;
+    std::vector<MarketHandle> commonFactors;  // shared[i] reads input commonFactors[i]
+    auto types = workloadTypes();
+    size_t options = 0;
+    for (size_t i = 0; i < types.size(); ++i) {
+        MarketHandle handle = handles[i % MARKET_INPUTS];
+        if (types[i] == InstrumentKind::Stock) {
+            embedded.emplace_back(makeInstrument<EmbeddedStockData>());
+            shared.emplace_back(makeInstrument<HandleStockData>());
+        } else {
+            OptionContract contract = optionContract(options++);
+            embedded.emplace_back(makeInstrument<EmbeddedOptionData>(contract));
+            shared.emplace_back(makeInstrument<HandleOptionData>(contract));
+        }
+        commonFactors.push_back(handle);
+    }
+
+    benchmark("Design: Embedded commonFactor, pricing", [&]() {
+        for (const auto& data : embedded) {
+            doNotOptimize(data->calculatePrice());
+        }
+    }, ITERATIONS);
+
+    benchmark("Design: MarketDataStore handles, pricing", [&]() {
+        MarketView market = store.read();
+        for (size_t i = 0; i < shared.size(); ++i) {
+            doNotOptimize(shared[i]->calculatePrice(market[commonFactors[i]]));
+        }
+    }, ITERATIONS);
+
+    // One update changes one shared input; embedded copies are scattered over the whole book.
+    size_t update = 0;
+    benchmark("Design: Embedded commonFactor, one market update", [&]() {
+        size_t input = update++ % MARKET_INPUTS;
+        double value = 0.5 + 1e-9 * static_cast<double>(update);
+        for (size_t i = input; i < embedded.size(); i += MARKET_INPUTS) embedded[i]->setCommonFactor(value);
+        clobberMemory();
+    }, UPDATE_ITERATIONS, 1);
+
+    benchmark("Design: MarketDataStore handles, one market update", [&]() {
+        size_t input = update++ % MARKET_INPUTS;
+        store.set(handles[input], 0.5 + 1e-9 * static_cast<double>(update));
+        store.publish();
+        clobberMemory();
+    }, UPDATE_ITERATIONS, 1);
+
+    if (benchmarkOptions().format != OutputFormat::Text) return;
+    std::cout << "    footprint per stock: embedded " << sizeof(EmbeddedStockData) << " bytes, handle "
+              << sizeof(HandleStockData) << " + " << sizeof(MarketHandle) << " bytes; store "
+              << store.size() * sizeof(double) * 2 << " bytes\n";
+    checkConsistency(store, handles);
+}
+
+} // namespace
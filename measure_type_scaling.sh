@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Compile time and object code size of type_scaling_pricer.cpp for each instrument type count.
+# Usage: ./measure_type_scaling.sh [compiler] [extra flags...]   (default: c++ -O2)
+# Each N is compiled on its own with -DSPEEDFP_TYPE_COUNT=N, so the numbers cover exactly one set
+# of generated types and all four dispatch patterns over it.
+
+cd "$(dirname "$0")"
+CXX=${1:-c++}
+shift
+FLAGS=("$@")
+[ ${#FLAGS[@]} -eq 0 ] && FLAGS=(-O2)
+OBJECT=$(mktemp /tmp/type_scaling.XXXXXX.o)
+trap 'rm -f "$OBJECT"' EXIT
+
+printf "%-6s %12s %14s\n" "types" "compile (s)" "text (bytes)"
+for N in 2 4 8 16 32 64; do
+    START=$(date +%s.%N)
+    "$CXX" -std=c++20 "${FLAGS[@]}" -DSPEEDFP_TYPE_COUNT=$N -c type_scaling_pricer.cpp -o "$OBJECT" || exit 1
+    END=$(date +%s.%N)
+    TEXT=$(size "$OBJECT" | awk 'NR == 2 { print $1 }')
+    printf "%-6s %12.2f %14s\n" "$N" "$(awk "BEGIN { print $END - $START }")" "$TEXT"
+done
@@ -0,0 +1,164 @@
+#include <cmath>
+#include <sstream>
+
+#include "benchmark.h"
+#include "monte_carlo.h"
+#include "price_cache.h"
+
+namespace {
+
+constexpr double DUPLICATE_RATIOS[] = {0.0, 0.5, 0.9, 0.99, 1.0};
+constexpr size_t CACHE_CAPACITY = 16'384;
+constexpr size_t MONTE_CARLO_BOOK = 128;  // Monte Carlo prices cost microseconds; keep its book small
+constexpr size_t MONTE_CARLO_STEPS = 16;
+
+class StockData;
+class OptionData;
+
+// Pricing models of increasing cost behind one interface.
+class Pricer {
+public:
+    virtual ~Pricer() = default;
+    virtual const char* name() const = 0;
+    virtual double priceStock(const StockData& data) const = 0;
+    virtual double priceOption(const OptionData& data) const = 0;
+};
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice(const Pricer& pricer) const = 0;
+    virtual PriceKey key() const = 0;
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    explicit StockData(double factor) : priceFactor(factor) {}
+    double calculatePrice(const Pricer& pricer) const override { return pricer.priceStock(*this); }
+    PriceKey key() const override { return PriceKey::of(0, priceFactor, commonFactor); }
+    double priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    explicit OptionData(const OptionTerms& t) : terms(t) {}
+    double calculatePrice(const Pricer& pricer) const override { return pricer.priceOption(*this); }
+    PriceKey key() const override {
+        return PriceKey::of(1, terms.spot, terms.strike, terms.rate, terms.expiry, terms.volatility,
+                            terms.isCall ? 1.0 : -1.0, commonFactor);
+    }
+    OptionTerms terms;
+};
+
+class FormulaPricer : public Pricer {
+public:
+    const char* name() const override { return "formula"; }
+    double priceStock(const StockData& data) const override { return data.priceFactor * 1.1 + data.getCommonFactor(); }
+    double priceOption(const OptionData& data) const override {
+        return optionPrice(data.terms.volatility, data.getCommonFactor(), optionContract(data.terms));
+    }
+};
+
+class BlackScholesPricer : public FormulaPricer {
+public:
+    const char* name() const override { return "Black-Scholes"; }
+    double priceOption(const OptionData& data) const override { return blackScholesPrice(data.terms); }
+};
+
+class MonteCarloPricer : public FormulaPricer {
+public:
+    explicit MonteCarloPricer(SimdLevel l) : level(l) {}
+    const char* name() const override { return "Monte Carlo Asian"; }
+    double priceOption(const OptionData& data) const override {
+        PathContract contract{data.terms, PathPayoff::Asian, 0.0, MONTE_CARLO_STEPS};
+        return priceMonteCarlo(level, contract, PATH_BLOCK, benchmarkOptions().seed, VarianceReduction::None).price;
+    }
+private:
+    SimdLevel level;
+};
+
+// Memoization in front of any Pricer. The epoch stands in for the market-data epoch: each pass is
+// a new tick, so only duplicates within one pass can hit.
+class MemoizedPricer {
+public:
+    MemoizedPricer(const Pricer& p, size_t capacity) : pricer(p), cache(capacity) {}
+    double calculatePrice(const Data& data) {
+        return cache.lookup(data.key(), epoch, [&]() { return data.calculatePrice(pricer); });
+    }
+    void nextEpoch() { ++epoch; }
+    PriceCache& priceCache() { return cache; }
+private:
+    const Pricer& pricer;
+    PriceCache cache;
+    uint64_t epoch = 0;
+};
+
+// A book where each kind has (1 - duplicateRatio) * count distinct terms, repeated round-robin.
+std::vector<InstrumentPtr<Data>> makeBook(size_t size, double duplicateRatio) {
+    auto types = workloadTypes(size);
+    size_t kindCount[2] = {0, 0};
+    for (auto kind : types) ++kindCount[kind == InstrumentKind::Option];
+    size_t distinct[2], seen[2] = {0, 0};
+    for (size_t k = 0; k < 2; ++k) {
+        distinct[k] = std::max<size_t>(1, static_cast<size_t>(std::llround(kindCount[k] * (1.0 - duplicateRatio))));
+    }
+
+    std::vector<InstrumentPtr<Data>> book;
+    for (auto kind : types) {
+        size_t k = kind == InstrumentKind::Option;
+        size_t j = seen[k]++ % distinct[k];
+        if (kind == InstrumentKind::Stock) {
+            book.emplace_back(makeInstrument<StockData>(1.2 + 1e-6 * j));
+        } else {
+            OptionTerms terms = sampleOptionTerms(j);
+            terms.spot += 1e-3 * j;
+            book.emplace_back(makeInstrument<OptionData>(terms));
+        }
+    }
+    return book;
+}
+
+SPEEDFP_DESIGN(memoized_pricer) {
+    FormulaPricer formula;
+    BlackScholesPricer blackScholes;
+    MonteCarloPricer monteCarlo(widestSimdLevel());
+    const Pricer* pricers[] = {&formula, &blackScholes, &monteCarlo};
+
+    for (const Pricer* pricer : pricers) {
+        bool heavy = pricer == &monteCarlo;
+        size_t size = heavy ? MONTE_CARLO_BOOK : bookSize();
+        size_t iterations = heavy ? 1 : ITERATIONS / 10;
+
+        auto unique = makeBook(size, 0.0);
+        auto uncached = benchmark(std::string("Design: Uncached pricer, ") + pricer->name(), [&]() {
+            for (const auto& data : unique) {
+                doNotOptimize(data->calculatePrice(*pricer));
+            }
+        }, iterations, size);
+
+        for (double ratio : DUPLICATE_RATIOS) {
+            auto book = makeBook(size, ratio);
+            MemoizedPricer memoized(*pricer, CACHE_CAPACITY);
+            std::ostringstream label;
+            label << "Design: Memoized pricer, " << pricer->name() << ", " << ratio * 100 << "% duplicates";
+            auto cached = benchmark(label.str(), [&]() {
+                memoized.nextEpoch();
+                for (const auto& data : book) {
+                    doNotOptimize(memoized.calculatePrice(*data));
+                }
+            }, iterations, size);
+
+            if (benchmarkOptions().format != OutputFormat::Text) continue;
+            const auto& counters = memoized.priceCache().counters();
+            double lookups = static_cast<double>(counters.hits + counters.misses);
+            std::cout << "    hit rate " << 100.0 * counters.hits / lookups << "%, "
+                      << 100.0 * counters.evictions / lookups << "% of lookups evicted, "
+                      << uncached.median / cached.median << "x the uncached throughput\n";
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,6 @@
+#include "monte_carlo.h"
+
+void simulatePathsScalar(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                         bool antithetic, PathSums& sums) {
+    simulatePathsLanes<ScalarLane>(contract, seed, firstPath, paths, antithetic, sums);
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "black_scholes.h"
+
+// Monte Carlo pricing of path-dependent options under geometric Brownian motion. Paths are
+// simulated in blocks of PATH_BLOCK held as structure-of-arrays state (log spot, running sum,
+// running log sum, running peak), one step at a time across the whole block, so every step is a
+// column kernel over lanes. Normals come from a counter-based Philox generator: the draw for
+// (path, step) depends only on the seed, so prices are the same however the paths are split
+// across chunks, threads or lanes.
+
+enum class PathPayoff { Asian, Barrier };
+
+inline const char* pathPayoffName(PathPayoff payoff) {
+    return payoff == PathPayoff::Asian ? "Asian" : "barrier";
+}
+
+// Asian: arithmetic average of the monitored spots against the strike.
+// Barrier: up-and-out; the vanilla payoff at expiry unless a monitored spot reached the barrier.
+struct PathContract {
+    OptionTerms terms;
+    PathPayoff payoff;
+    double barrier;
+    size_t steps;  // monitoring dates, evenly spaced up to expiry
+};
+
+inline PathContract samplePathContract(size_t i, size_t steps) {
+    OptionTerms terms = sampleOptionTerms(i);
+    return {terms, i % 4 < 2 ? PathPayoff::Asian : PathPayoff::Barrier, terms.spot * 1.3, steps};
+}
+
+enum class VarianceReduction { None, Antithetic, ControlVariate };
+
+inline const char* varianceReductionName(VarianceReduction reduction) {
+    switch (reduction) {
+    case VarianceReduction::Antithetic: return "antithetic";
+    case VarianceReduction::ControlVariate: return "control variate";
+    default: return "plain";
+    }
+}
+
+// Per-sample sums of the payoff Y and its control X (geometric Asian for Asian contracts, the
+// vanilla option for barriers). With antithetic paths a sample is the mean of a path pair.
+struct PathSums {
+    double payoff = 0;
+    double payoffSq = 0;
+    double control = 0;
+    double controlSq = 0;
+    double cross = 0;
+    size_t samples = 0;
+};
+
+inline void mergePathSums(PathSums& total, const PathSums& part) {
+    total.payoff += part.payoff;
+    total.payoffSq += part.payoffSq;
+    total.control += part.control;
+    total.controlSq += part.controlSq;
+    total.cross += part.cross;
+    total.samples += part.samples;
+}
+
+constexpr size_t PATH_BLOCK = 256;          // paths in flight per block; a multiple of 8 lanes
+constexpr size_t PATH_CHUNK = 16 * PATH_BLOCK;  // paths per independently reduced chunk
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"). Writes uniforms in
+// (0, 1) for draws [firstDraw, firstDraw + count) of one step; both must be multiples of 4. The
+// lane type only gives each instruction-set file its own instantiation (see simd_lanes.h); the
+// integer loop is left to the compiler's vectorizer.
+template <typename L>
+inline void philoxUniforms(uint64_t seed, uint64_t firstDraw, uint32_t step, size_t count, double* out) {
+    for (size_t q = 0; q < count / 4; ++q) {
+        uint64_t block = firstDraw / 4 + q;
+        uint32_t c0 = static_cast<uint32_t>(block), c1 = static_cast<uint32_t>(block >> 32), c2 = step, c3 = 0;
+        uint32_t k0 = static_cast<uint32_t>(seed), k1 = static_cast<uint32_t>(seed >> 32);
+        for (int round = 0; round < 10; ++round) {
+            uint64_t p0 = uint64_t{0xD2511F53} * c0;
+            uint64_t p1 = uint64_t{0xCD9E8D57} * c2;
+            uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+            c1 = static_cast<uint32_t>(p1);
+            c3 = static_cast<uint32_t>(p0);
+            c0 = n0;
+            c2 = n2;
+            k0 += 0x9E3779B9;
+            k1 += 0xBB67AE85;
+        }
+        out[4 * q] = (c0 + 0.5) * 0x1p-32;
+        out[4 * q + 1] = (c1 + 0.5) * 0x1p-32;
+        out[4 * q + 2] = (c2 + 0.5) * 0x1p-32;
+        out[4 * q + 3] = (c3 + 0.5) * 0x1p-32;
+    }
+}
+
+// Simulates paths [firstPath, firstPath + paths), both multiples of PATH_BLOCK, and adds them to
+// sums. Antithetic blocks draw half the normals and run the second half of the block on -z.
+template <typename L>
+inline void simulatePathsLanes(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                               bool antithetic, PathSums& sums) {
+    alignas(64) double uniforms[PATH_BLOCK];
+    alignas(64) double normals[PATH_BLOCK];
+    alignas(64) double logSpot[PATH_BLOCK];
+    alignas(64) double spotSum[PATH_BLOCK];
+    alignas(64) double logSum[PATH_BLOCK];
+    alignas(64) double peak[PATH_BLOCK];
+    alignas(64) double payoff[PATH_BLOCK];
+    alignas(64) double control[PATH_BLOCK];
+
+    const OptionTerms& terms = contract.terms;
+    double dt = terms.expiry / contract.steps;
+    const L drift = L::splat((terms.rate - 0.5 * terms.volatility * terms.volatility) * dt);
+    const L diffusion = L::splat(terms.volatility * std::sqrt(dt));
+    const L strike = L::splat(terms.strike);
+    const L barrier = L::splat(contract.barrier);
+    const L callPut = L::splat(terms.isCall ? 1.0 : -1.0);
+    const L invSteps = L::splat(1.0 / contract.steps);
+    const L zero = L::splat(0.0);
+    const size_t draws = antithetic ? PATH_BLOCK / 2 : PATH_BLOCK;
+    const double logSpot0 = std::log(terms.spot);
+
+    for (size_t block = firstPath; block < firstPath + paths; block += PATH_BLOCK) {
+        // Plain loops rather than std::fill, whose instantiation would be shared with the scalar build.
+        for (size_t i = 0; i < PATH_BLOCK; ++i) {
+            logSpot[i] = logSpot0;
+            spotSum[i] = logSum[i] = peak[i] = 0.0;
+        }
+
+        uint64_t firstDraw = antithetic ? block / 2 : block;
+        for (size_t step = 0; step < contract.steps; ++step) {
+            philoxUniforms<L>(seed, firstDraw, static_cast<uint32_t>(step), draws, uniforms);
+            for (size_t i = 0; i < draws; i += L::WIDTH) {
+                L z = vnormInv(L::load(uniforms + i));
+                z.store(normals + i);
+                if (antithetic) (zero - z).store(normals + draws + i);
+            }
+            for (size_t i = 0; i < PATH_BLOCK; i += L::WIDTH) {
+                L x = L::load(logSpot + i) + drift + diffusion * L::load(normals + i);
+                L spot = vexp(x);
+                x.store(logSpot + i);
+                (L::load(spotSum + i) + spot).store(spotSum + i);
+                (L::load(logSum + i) + x).store(logSum + i);
+                L::max(L::load(peak + i), spot).store(peak + i);
+            }
+        }
+
+        for (size_t i = 0; i < PATH_BLOCK; i += L::WIDTH) {
+            if (contract.payoff == PathPayoff::Asian) {
+                L average = L::load(spotSum + i) * invSteps;
+                L geometric = vexp(L::load(logSum + i) * invSteps);
+                L::max(callPut * (average - strike), zero).store(payoff + i);
+                L::max(callPut * (geometric - strike), zero).store(control + i);
+            } else {
+                L vanilla = L::max(callPut * (vexp(L::load(logSpot + i)) - strike), zero);
+                L::selectLess(L::load(peak + i), barrier, vanilla, zero).store(payoff + i);
+                vanilla.store(control + i);
+            }
+        }
+
+        size_t samples = antithetic ? draws : PATH_BLOCK;
+        for (size_t i = 0; i < samples; ++i) {
+            double y = antithetic ? 0.5 * (payoff[i] + payoff[i + draws]) : payoff[i];
+            double x = antithetic ? 0.5 * (control[i] + control[i + draws]) : control[i];
+            sums.payoff += y;
+            sums.payoffSq += y * y;
+            sums.control += x;
+            sums.controlSq += x * x;
+            sums.cross += x * y;
+        }
+        sums.samples += samples;
+    }
+}
+
+// Defined in monte_carlo.cpp, monte_carlo_avx2.cpp and monte_carlo_avx512.cpp, with the same
+// scalar fallback as the Black-Scholes kernels.
+void simulatePathsScalar(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                         bool antithetic, PathSums& sums);
+void simulatePathsAvx2(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                       bool antithetic, PathSums& sums);
+void simulatePathsAvx512(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                         bool antithetic, PathSums& sums);
+
+inline void simulatePaths(SimdLevel level, const PathContract& contract, uint64_t seed, size_t firstPath,
+                          size_t paths, bool antithetic, PathSums& sums) {
+    if (level == SimdLevel::Avx512) return simulatePathsAvx512(contract, seed, firstPath, paths, antithetic, sums);
+    if (level == SimdLevel::Avx2) return simulatePathsAvx2(contract, seed, firstPath, paths, antithetic, sums);
+    simulatePathsScalar(contract, seed, firstPath, paths, antithetic, sums);
+}
+
+// Undiscounted expectation of the control payoff. The geometric average of discretely monitored
+// GBM is lognormal, so its option has a Black-Scholes-style closed form.
+inline double controlExpectation(const PathContract& contract) {
+    const OptionTerms& terms = contract.terms;
+    double growth = std::exp(terms.rate * terms.expiry);
+    if (contract.payoff == PathPayoff::Barrier) return blackScholesReference(terms) * growth;
+
+    double n = static_cast<double>(contract.steps);
+    double variance = terms.volatility * terms.volatility * terms.expiry * (n + 1) * (2 * n + 1) / (6 * n * n);
+    double mean = std::log(terms.spot) +
+                  (terms.rate - 0.5 * terms.volatility * terms.volatility) * terms.expiry * (n + 1) / (2 * n);
+    double deviation = std::sqrt(variance);
+    double d1 = (mean - std::log(terms.strike) + variance) / deviation;
+    double d2 = d1 - deviation;
+    double sign = terms.isCall ? 1.0 : -1.0;
+    auto normCdf = [](double x) { return 0.5 * std::erfc(-x / std::sqrt(2.0)); };
+    return sign * (std::exp(mean + 0.5 * variance) * normCdf(sign * d1) - terms.strike * normCdf(sign * d2));
+}
+
+struct MonteCarloEstimate {
+    double price;
+    double stdError;
+    size_t paths;  // simulated paths, counting both halves of an antithetic pair
+};
+
+inline MonteCarloEstimate monteCarloEstimate(const PathContract& contract, const PathSums& sums,
+                                             VarianceReduction reduction) {
+    double n = static_cast<double>(sums.samples);
+    double meanY = sums.payoff / n;
+    double varY = (sums.payoffSq - n * meanY * meanY) / (n - 1);
+    double estimate = meanY;
+    double variance = varY;
+    if (reduction == VarianceReduction::ControlVariate) {
+        double meanX = sums.control / n;
+        double varX = (sums.controlSq - n * meanX * meanX) / (n - 1);
+        double cov = (sums.cross - n * meanX * meanY) / (n - 1);
+        if (varX > 0) {
+            estimate -= cov / varX * (meanX - controlExpectation(contract));
+            variance = std::max(0.0, varY - cov * cov / varX);
+        }
+    }
+    double discount = std::exp(-contract.terms.rate * contract.terms.expiry);
+    size_t paths = sums.samples * (reduction == VarianceReduction::Antithetic ? 2 : 1);
+    return {discount * estimate, discount * std::sqrt(variance / n), paths};
+}
+
+// Paths are rounded up to whole blocks and summed chunk by chunk in path order, the same order
+// MonteCarloEngine (parallel_engine.h) reduces in, so serial and threaded prices are bit-identical.
+inline size_t monteCarloChunks(size_t paths) { return (paths + PATH_CHUNK - 1) / PATH_CHUNK; }
+
+inline void simulateChunk(SimdLevel level, const PathContract& contract, size_t paths, uint64_t seed,
+                          VarianceReduction reduction, size_t chunk, PathSums& sums) {
+    size_t first = chunk * PATH_CHUNK;
+    size_t count = std::min(PATH_CHUNK, paths - first);
+    count = (count + PATH_BLOCK - 1) / PATH_BLOCK * PATH_BLOCK;
+    simulatePaths(level, contract, seed, first, count, reduction == VarianceReduction::Antithetic, sums);
+}
+
+inline MonteCarloEstimate priceMonteCarlo(SimdLevel level, const PathContract& contract, size_t paths, uint64_t seed,
+                                          VarianceReduction reduction) {
+    PathSums total;
+    for (size_t chunk = 0; chunk < monteCarloChunks(paths); ++chunk) {
+        PathSums sums;
+        simulateChunk(level, contract, paths, seed, reduction, chunk, sums);
+        mergePathSums(total, sums);
+    }
+    return monteCarloEstimate(contract, total, reduction);
+}
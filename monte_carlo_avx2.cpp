@@ -0,0 +1,12 @@
+// Compiled with AVX2 and FMA enabled; only reached when the CPU supports them.
+#include "monte_carlo.h"
+#include "simd_lanes.h"
+
+void simulatePathsAvx2(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                       bool antithetic, PathSums& sums) {
+#ifdef __AVX2__
+    simulatePathsLanes<Avx2Lane>(contract, seed, firstPath, paths, antithetic, sums);
+#else
+    simulatePathsScalar(contract, seed, firstPath, paths, antithetic, sums);
+#endif
+}
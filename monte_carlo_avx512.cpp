@@ -0,0 +1,12 @@
+// Compiled with AVX-512F enabled; only reached when the CPU supports it.
+#include "monte_carlo.h"
+#include "simd_lanes.h"
+
+void simulatePathsAvx512(const PathContract& contract, uint64_t seed, size_t firstPath, size_t paths,
+                         bool antithetic, PathSums& sums) {
+#ifdef __AVX512F__
+    simulatePathsLanes<Avx512Lane>(contract, seed, firstPath, paths, antithetic, sums);
+#else
+    simulatePathsScalar(contract, seed, firstPath, paths, antithetic, sums);
+#endif
+}
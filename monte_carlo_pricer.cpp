@@ -0,0 +1,155 @@
+#include <chrono>
+
+#include "benchmark.h"
+#include "monte_carlo.h"
+#include "parallel_engine.h"
+
+namespace {
+
+constexpr size_t BOOK_SIZE = 64;            // instruments in the per-object book
+constexpr size_t BOOK_PATHS = PATH_BLOCK;   // paths per path-dependent option in the book
+constexpr size_t BOOK_STEPS = 32;
+constexpr size_t ENGINE_PATHS = 4 * PATH_CHUNK;
+constexpr size_t ENGINE_STEPS = 64;
+// A Monte Carlo price costs thousands of times a closed-form one; scale the pass counts down so
+// every run stays around a second.
+constexpr size_t BOOK_ITERATIONS = 1;
+constexpr size_t ENGINE_ITERATIONS = ITERATIONS / 500;
+constexpr size_t ERROR_PATHS[] = {PATH_CHUNK, 4 * PATH_CHUNK, 16 * PATH_CHUNK, 64 * PATH_CHUNK};
+
+class MonteCarloPricer;
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+    virtual double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData() : priceFactor(1.2) {}
+    double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
+private:
+    double priceFactor;
+};
+
+class PathOptionData : public Data {
+public:
+    PathOptionData(MonteCarloPricer* p, const PathContract& c) : pricer(p), contract(c) {}
+    double calculatePrice() const override;
+    MonteCarloPricer* pricer;
+    PathContract contract;
+};
+
+// The path-dependent counterpart of OptionPricer: prices one contract per call on its kernel.
+class MonteCarloPricer {
+public:
+    SimdLevel level = SimdLevel::Scalar;
+    double calculatePrice(const PathOptionData& data) const {
+        return priceMonteCarlo(level, data.contract, BOOK_PATHS, benchmarkOptions().seed, VarianceReduction::None).price;
+    }
+};
+
+double PathOptionData::calculatePrice() const { return pricer->calculatePrice(*this); }
+
+PathContract engineContract(PathPayoff payoff) {
+    return {{100.0, 100.0, 0.03, 1.0, 0.2, true}, payoff, 130.0, ENGINE_STEPS};
+}
+
+// Standard error reached against wall time as the path count grows, for each variance reduction.
+void reportErrorAgainstTime(SimdLevel level, PathPayoff payoff) {
+    using Clock = std::chrono::steady_clock;
+    PathContract contract = engineContract(payoff);
+    for (VarianceReduction reduction :
+         {VarianceReduction::None, VarianceReduction::Antithetic, VarianceReduction::ControlVariate}) {
+        std::cout << "    error vs time, " << pathPayoffName(payoff) << ", " << varianceReductionName(reduction) << ":";
+        for (size_t paths : ERROR_PATHS) {
+            auto start = Clock::now();
+            MonteCarloEstimate estimate = priceMonteCarlo(level, contract, paths, benchmarkOptions().seed, reduction);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            std::cout << " " << estimate.paths << " paths " << ms << " ms +-" << estimate.stdError << ";";
+        }
+        std::cout << "\n";
+    }
+}
+
+SPEEDFP_DESIGN(monte_carlo_pricer) {
+    // The books are fixed-size (a 10K-instrument Monte Carlo book would take minutes per sample), so
+    // a size sweep would only repeat the same work under other labels: run at the first size only.
+    const auto& sizes = benchmarkOptions().sizes;
+    if (sizes.size() > 1 && bookSize() != sizes.front()) {
+        if (benchmarkOptions().format == OutputFormat::Text) {
+            std::cout << "Design: Monte Carlo - fixed " << BOOK_SIZE << "-instrument book, skipped at "
+                      << bookSize() << " items (already run at " << sizes.front() << ")\n";
+        }
+        return;
+    }
+
+    MonteCarloPricer pricer;
+    const uint64_t seed = benchmarkOptions().seed;
+
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    auto types = workloadTypes(BOOK_SIZE);
+    for (size_t i = 0; i < types.size(); ++i) {
+        if (types[i] == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+        } else {
+            dataSamples.emplace_back(makeInstrument<PathOptionData>(&pricer, samplePathContract(i, BOOK_STEPS)));
+        }
+    }
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (!simdLevelSupported(level)) continue;
+        pricer.level = level;
+        benchmark(std::string("Design: Virtual function, Monte Carlo book, ") + simdLevelName(level) + " kernel", [&]() {
+            for (const auto& data : dataSamples) {
+                doNotOptimize(data->calculatePrice());
+            }
+        }, BOOK_ITERATIONS, dataSamples.size());
+    }
+
+    // Engine throughput on one contract, reported per path.
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (!simdLevelSupported(level)) continue;
+        for (PathPayoff payoff : {PathPayoff::Asian, PathPayoff::Barrier}) {
+            PathContract contract = engineContract(payoff);
+            MonteCarloEstimate estimate{};
+            std::string label = std::string("Design: Monte Carlo engine, ") + pathPayoffName(payoff) + ", " +
+                                simdLevelName(level) + " kernel";
+            auto result = benchmark(label, [&]() {
+                estimate = priceMonteCarlo(level, contract, ENGINE_PATHS, seed, VarianceReduction::None);
+                doNotOptimize(estimate);
+            }, ENGINE_ITERATIONS, ENGINE_PATHS);
+            if (benchmarkOptions().format != OutputFormat::Text) continue;
+            std::cout << "    " << 1e3 / result.median << " M paths/s, price " << estimate.price << " +- "
+                      << estimate.stdError << "\n";
+        }
+    }
+
+    if (benchmarkOptions().format == OutputFormat::Text) {
+        for (PathPayoff payoff : {PathPayoff::Asian, PathPayoff::Barrier}) {
+            reportErrorAgainstTime(widestSimdLevel(), payoff);
+        }
+    }
+
+    // Path split across threads when --threads is given.
+    const auto& options = benchmarkOptions();
+    PathContract contract = engineContract(PathPayoff::Asian);
+    double serial = priceMonteCarlo(widestSimdLevel(), contract, ENGINE_PATHS, seed, VarianceReduction::None).price;
+    for (size_t threads : options.threads) {
+        MonteCarloEngine engine(threads, options.pinThreads);
+        MonteCarloEstimate estimate{};
+        auto result = benchmark("Design: Monte Carlo engine, Asian (" + std::to_string(threads) + " threads)", [&]() {
+            estimate = engine.price(widestSimdLevel(), contract, ENGINE_PATHS, seed, VarianceReduction::None);
+            doNotOptimize(estimate);
+        }, ENGINE_ITERATIONS, ENGINE_PATHS);
+        if (options.format != OutputFormat::Text) continue;
+        std::cout << "    " << 1e3 / result.median << " M paths/s, "
+                  << (estimate.price == serial ? "bit-identical to" : "DIFFERS from") << " the serial price\n";
+    }
+}
+
+} // namespace
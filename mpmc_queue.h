@@ -0,0 +1,86 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+#include "instrument_book.h"
+
+// Bounded lock-free queue for any number of producer and consumer threads (Vyukov's array queue).
+// Every cell carries a sequence number that says whose turn it is: a producer may fill cell i when
+// its sequence equals the enqueue position, a consumer may empty it when the sequence is one past
+// it. A thread claims a position with one compare-exchange, and only threads racing for the same
+// end of the queue ever contend; enqueue and dequeue positions live on their own cache lines.
+template <typename T>
+class MpmcQueue {
+public:
+    // capacity is rounded up to a power of two.
+    explicit MpmcQueue(size_t capacity)
+        : size(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(size - 1), cells(new Cell[size]) {
+        for (size_t i = 0; i < size; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // False when the queue is full.
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // False when the queue is empty.
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.value.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeuePos.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(pos + size, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos.value.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t capacity() const { return size; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    struct alignas(COLUMN_ALIGNMENT) Position {
+        std::atomic<size_t> value{0};
+    };
+
+    size_t size;
+    size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    Position enqueuePos;
+    Position dequeuePos;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "black_scholes.h"
+#include "instrument_book.h"
+
+// What an option costs to price. By default it is the original volatility * OPTION_SCALE +
+// commonFactor, which the README numbers were measured with. Configuring with
+// -DSPEEDFP_OPTION_MODEL=BLACK_SCHOLES prices each option as a Black-Scholes European on its own
+// contract terms (OptionContract) instead, in every design: the per-object ones through
+// optionPrice() and the SoA book through the batch kernels. The designs can then be compared at the
+// point where the pricing work starts to dwarf the dispatch.
+
+// For OptionContract members: takes no space while the contract is empty, so the per-object
+// designs keep their original layout in the default model.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SPEEDFP_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define SPEEDFP_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
+// The contract of the option-th option of a book, counting options only. Every design numbers its
+// options in book order, so all of them price the same contracts.
+inline OptionContract optionContract(size_t option) {
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    OptionTerms terms = sampleOptionTerms(option);
+    return {terms.spot, terms.strike, terms.rate, terms.expiry, terms.isCall ? 1.0 : -1.0};
+#else
+    (void)option;
+    return {};
+#endif
+}
+
+// For designs that already carry full OptionTerms; their volatility still comes from the design.
+inline OptionContract optionContract(const OptionTerms& terms) {
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    return {terms.spot, terms.strike, terms.rate, terms.expiry, terms.isCall ? 1.0 : -1.0};
+#else
+    (void)terms;
+    return {};
+#endif
+}
+
+inline double optionPrice(double volatility, double commonFactor, const OptionContract& contract) {
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    return blackScholesPrice({contract.spot, contract.strike, contract.rate, contract.expiry, volatility,
+                              contract.callPut > 0}) + commonFactor;
+#else
+    (void)contract;
+    return volatility * OPTION_SCALE + commonFactor;
+#endif
+}
+
+// Prices every instrument in the book, one column at a time. Outputs must hold one entry per
+// instrument of their type.
+inline void priceBook(SimdLevel level, const InstrumentBook& book, double* stockPrices, double* optionPrices) {
+    priceColumn(level, book.stocks.priceFactor.data(), book.stocks.commonFactor.data(), STOCK_SCALE, stockPrices,
+                book.stocks.priceFactor.size());
+    const OptionColumns& options = book.options;
+#ifdef SPEEDFP_BLACK_SCHOLES_OPTIONS
+    priceBlackScholes(level, {options.spot.data(), options.strike.data(), options.rate.data(), options.expiry.data(),
+                              options.volatility.data(), options.callPut.data(), options.volatility.size()},
+                      optionPrices);
+    for (size_t i = 0; i < options.volatility.size(); ++i) optionPrices[i] += options.commonFactor[i];
+#else
+    priceColumn(level, options.volatility.data(), options.commonFactor.data(), OPTION_SCALE, optionPrices,
+                options.volatility.size());
+#endif
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "instrument_book.h"
+#include "monte_carlo.h"
+#include "thread_pool.h"
+
+// Prices a book in fixed-size chunks on a WorkStealingPool. Each chunk writes its prices into its
+// own cache-line aligned slice of the output buffer and accumulates its total in its own slot;
+// totals are then reduced in chunk order, so the portfolio total is bit-identical for every thread
+// count and schedule. With packed output the chunk totals sit next to each other instead of one
+// per cache line, which exposes the false sharing the padding avoids.
+class ParallelPricingEngine {
+public:
+    static constexpr size_t CHUNK_SIZE = 4096;  // a multiple of 8 doubles keeps slices line aligned
+    static constexpr size_t LINE_DOUBLES = COLUMN_ALIGNMENT / sizeof(double);
+
+    ParallelPricingEngine(size_t threads, bool pin, bool packed)
+        : pool(threads, pin), totalStride(packed ? 1 : LINE_DOUBLES) {}
+
+    size_t threads() const { return pool.size(); }
+
+    template <typename Book, typename PriceOne>
+    double price(const Book& book, PriceOne priceOne) {
+        size_t n = book.size();
+        size_t chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (output.size() < n) output.resize(n);
+        if (totals.size() < chunks * totalStride) totals.resize(chunks * totalStride);
+
+        pool.parallelFor(chunks, [&](size_t chunk) {
+            double& total = totals[chunk * totalStride];
+            total = 0;
+            size_t end = std::min(n, (chunk + 1) * CHUNK_SIZE);
+            for (size_t i = chunk * CHUNK_SIZE; i < end; ++i) {
+                output[i] = priceOne(book[i]);
+                total += output[i];
+            }
+        });
+
+        double portfolio = 0;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            portfolio += totals[chunk * totalStride];
+        }
+        return portfolio;
+    }
+
+    const AlignedVector<double>& prices() const { return output; }
+
+private:
+    WorkStealingPool pool;
+    size_t totalStride;
+    AlignedVector<double> output;
+    AlignedVector<double> totals;
+};
+
+// Runs a design's book on 1..N threads when --threads is given; a no-op otherwise. priceOne maps
+// one book element to its price.
+template <typename Book, typename PriceOne>
+void benchmarkScaling(const std::string& label, const Book& book, PriceOne priceOne) {
+    const auto& options = benchmarkOptions();
+    std::vector<std::pair<size_t, double>> throughput;  // threads, million instruments per second
+    for (size_t threads : options.threads) {
+        ParallelPricingEngine engine(threads, options.pinThreads, options.packedOutput);
+        auto result = benchmark(label + " (" + std::to_string(threads) + " threads)", [&]() {
+            doNotOptimize(engine.price(book, priceOne));
+        }, ITERATIONS, book.size());
+        throughput.emplace_back(threads, 1e3 / result.median);
+    }
+
+    if (throughput.empty() || options.format != OutputFormat::Text) return;
+    std::cout << "    scaling:";
+    for (const auto& [threads, rate] : throughput) {
+        std::cout << " " << threads << "T " << rate << " M/s (" << rate / throughput.front().second << "x)";
+    }
+    std::cout << "\n";
+}
+
+// Splits a Monte Carlo run into PATH_CHUNK chunks on a WorkStealingPool. Each chunk sums into its
+// own cache-line aligned slot and the slots are merged in chunk order; with the counter-based
+// generator every chunk sees the same draws on any thread, so the estimate matches
+// priceMonteCarlo() bit for bit.
+class MonteCarloEngine {
+public:
+    MonteCarloEngine(size_t threads, bool pin) : pool(threads, pin) {}
+
+    size_t threads() const { return pool.size(); }
+
+    MonteCarloEstimate price(SimdLevel level, const PathContract& contract, size_t paths, uint64_t seed,
+                             VarianceReduction reduction) {
+        size_t chunks = monteCarloChunks(paths);
+        if (slots.size() < chunks) slots.resize(chunks);
+        pool.parallelFor(chunks, [&](size_t chunk) {
+            slots[chunk].sums = PathSums{};
+            simulateChunk(level, contract, paths, seed, reduction, chunk, slots[chunk].sums);
+        });
+
+        PathSums total;
+        for (size_t chunk = 0; chunk < chunks; ++chunk) mergePathSums(total, slots[chunk].sums);
+        return monteCarloEstimate(contract, total, reduction);
+    }
+
+private:
+    struct alignas(COLUMN_ALIGNMENT) Slot {
+        PathSums sums;
+    };
+
+    WorkStealingPool pool;
+    std::vector<Slot> slots;
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters around the timed region, enabled with SPEEDFP_PERF=1 or --perf.
+// Counters the kernel refuses to open (containers, perf_event_paranoid, VMs) are skipped one by one,
+// so a run degrades to timing only instead of failing.
+inline bool perfCountersRequested() {
+    const char* env = std::getenv("SPEEDFP_PERF");
+    return env != nullptr && std::strcmp(env, "0") != 0;
+}
+
+using CounterValues = std::vector<std::pair<std::string, double>>;
+
+#ifdef __linux__
+
+class PerfCounters {
+public:
+    PerfCounters() {
+        constexpr uint64_t readMiss = PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16;
+        open("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open("branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open("L1D-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | readMiss);
+        open("LLC-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | readMiss);
+        open("iTLB-misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_ITLB | readMiss);
+    }
+
+    ~PerfCounters() {
+        for (const auto& counter : counters) close(counter.fd);
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return !counters.empty(); }
+
+    void start() {
+        for (const auto& counter : counters) {
+            ioctl(counter.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    void stop() {
+        for (const auto& counter : counters) ioctl(counter.fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    // Counts scaled up for the time each counter was multiplexed out.
+    CounterValues read() const {
+        CounterValues values;
+        for (const auto& counter : counters) {
+            uint64_t buffer[3] = {};  // value, time enabled, time running
+            if (::read(counter.fd, buffer, sizeof(buffer)) != sizeof(buffer) || buffer[2] == 0) continue;
+            double scale = static_cast<double>(buffer[1]) / buffer[2];
+            values.emplace_back(counter.name, buffer[0] * scale);
+        }
+        return values;
+    }
+
+private:
+    struct Counter {
+        std::string name;
+        int fd;
+    };
+
+    void open(const char* name, uint32_t type, uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd >= 0) counters.push_back({name, fd});
+    }
+
+    std::vector<Counter> counters;
+};
+
+#else
+
+class PerfCounters {
+public:
+    bool available() const { return false; }
+    void start() {}
+    void stop() {}
+    CounterValues read() const { return {}; }
+};
+
+#endif
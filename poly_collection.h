@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Type-partitioned collection in the style of Boost.PolyCollection: one contiguous segment per
+// concrete type, so for_each resolves the type once per segment and then runs a tight loop the
+// compiler can inline and vectorize.
+template <typename... Ts>
+class PolyCollection {
+public:
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        return segment<T>().emplace_back(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    std::vector<T>& segment() { return std::get<std::vector<T>>(segments); }
+    template <typename T>
+    const std::vector<T>& segment() const { return std::get<std::vector<T>>(segments); }
+
+    size_t size() const { return (segment<Ts>().size() + ...); }
+
+    template <typename F>
+    void for_each(F&& f) const {
+        (forEachIn(segment<Ts>(), f), ...);
+    }
+
+private:
+    template <typename T, typename F>
+    static void forEachIn(const std::vector<T>& items, F& f) {
+        for (const auto& item : items) f(item);
+    }
+
+    std::tuple<std::vector<Ts>...> segments;
+};
+
+// PolyCollection that also remembers insertion order through a permutation index. for_each_indexed
+// keeps the per-segment loop and hands out each element's original position so results can be
+// scattered back in order; for_each_ordered walks the original order and dispatches per element.
+template <typename... Ts>
+class OrderedPolyCollection {
+public:
+    template <typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        constexpr uint32_t type = indexOf<T>();
+        auto& items = collection.template segment<T>();
+        order.push_back({type, static_cast<uint32_t>(items.size())});
+        std::get<type>(positions).push_back(static_cast<uint32_t>(order.size() - 1));
+        return collection.template emplace<T>(std::forward<Args>(args)...);
+    }
+
+    size_t size() const { return order.size(); }
+
+    template <typename F>
+    void for_each(F&& f) const { collection.for_each(f); }
+
+    // f(originalIndex, item), one segment at a time.
+    template <typename F>
+    void for_each_indexed(F&& f) const {
+        forEachIndexed(f, std::index_sequence_for<Ts...>{});
+    }
+
+    // f(item) in insertion order.
+    template <typename F>
+    void for_each_ordered(F&& f) const {
+        for (const Slot& slot : order) {
+            visitSlot(slot, f, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+private:
+    struct Slot {
+        uint32_t type;
+        uint32_t index;
+    };
+
+    template <typename>
+    using Positions = std::vector<uint32_t>;
+
+    template <typename T>
+    static constexpr uint32_t indexOf() {
+        uint32_t index = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<T, Ts>, index += found ? 0 : 1), ...);
+        return index;
+    }
+
+    template <typename F, size_t... Is>
+    void forEachIndexed(F& f, std::index_sequence<Is...>) const {
+        (forEachIndexedIn(collection.template segment<Ts>(), std::get<Is>(positions), f), ...);
+    }
+
+    template <typename T, typename F>
+    static void forEachIndexedIn(const std::vector<T>& items, const std::vector<uint32_t>& position, F& f) {
+        for (size_t i = 0; i < items.size(); ++i) f(position[i], items[i]);
+    }
+
+    template <typename F, size_t... Is>
+    void visitSlot(const Slot& slot, F& f, std::index_sequence<Is...>) const {
+        ((slot.type == Is ? (f(collection.template segment<Ts>()[slot.index]), true) : false) || ...);
+    }
+
+    PolyCollection<Ts...> collection;
+    std::vector<Slot> order;
+    std::tuple<Positions<Ts>...> positions;  // original index of every element, per segment
+};
@@ -0,0 +1,85 @@
+#include "benchmark.h"
+#include "poly_collection.h"
+
+namespace {
+
+class StockPricer;
+class OptionPricer;
+
+class Data {
+public:
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    double commonFactor = 0.5;
+};
+
+class StockData : public Data {
+public:
+    StockData(StockPricer* p) : Data(), pricer(p), priceFactor(1.2) {}
+    double calculatePrice() const;
+    StockPricer* pricer;
+    double priceFactor;
+};
+
+class OptionData : public Data {
+public:
+    OptionData(OptionPricer* p, const OptionContract& terms) : Data(), pricer(p), volatility(0.8), contract(terms) {}
+    double calculatePrice() const;
+    OptionPricer* pricer;
+    double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class StockPricer {
+public:
+    double calculatePrice(const StockData* data) const {
+        return data->priceFactor * 1.1 + data->getCommonFactor();
+    }
+};
+
+class OptionPricer {
+public:
+    double calculatePrice(const OptionData* data) const {
+        return optionPrice(data->volatility, data->getCommonFactor(), data->contract);
+    }
+};
+
+double StockData::calculatePrice() const { return pricer->calculatePrice(this); }
+double OptionData::calculatePrice() const { return pricer->calculatePrice(this); }
+
+SPEEDFP_DESIGN(poly_collection_pricer) {
+    StockPricer stockPricer;
+    OptionPricer optionPricer;
+
+    OrderedPolyCollection<StockData, OptionData> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace<StockData>(&stockPricer);
+        } else {
+            dataSamples.emplace<OptionData>(&optionPricer, optionContract(options++));
+        }
+    }
+    std::vector<double> prices(dataSamples.size());
+
+    benchmark("Design: Poly collection, dispatch per segment", [&]() {
+        dataSamples.for_each([&](const auto& data) {
+            doNotOptimize(data.calculatePrice());
+        });
+    }, ITERATIONS);
+
+    benchmark("Design: Poly collection, per segment into original order", [&]() {
+        dataSamples.for_each_indexed([&](uint32_t index, const auto& data) {
+            prices[index] = data.calculatePrice();
+        });
+        clobberMemory();
+    }, ITERATIONS);
+
+    benchmark("Design: Poly collection, dispatch per item in original order", [&]() {
+        dataSamples.for_each_ordered([&](const auto& data) {
+            doNotOptimize(data.calculatePrice());
+        });
+    }, ITERATIONS);
+}
+
+} // namespace
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPEEDFP_MMAP 1
+#endif
+
+#include "instrument_book.h"
+#include "workload.h"
+
+// Binary portfolio files: a book stored as little-endian columns that can be memory-mapped and
+// priced where they lie, or walked once to build any in-memory layout.
+//
+//   PortfolioHeader   magic, version, instrument count and one PortfolioSection per type
+//   kinds             one InstrumentKind byte per instrument, in book order
+//   stock section     priceFactor[], commonFactor[]   (doubles)
+//   option section    volatility[], commonFactor[]    (doubles)
+//
+// Every column starts on a COLUMN_ALIGNMENT boundary, so the SoA kernels in instrument_book.h can
+// run straight off the mapping. Readers reject other versions instead of guessing.
+
+constexpr char PORTFOLIO_MAGIC[8] = {'S', 'P', 'E', 'E', 'D', 'F', 'P', 'B'};
+constexpr uint32_t PORTFOLIO_VERSION = 1;
+constexpr uint32_t PORTFOLIO_COLUMNS = 2;
+
+struct PortfolioSection {
+    uint32_t kind;  // InstrumentKind
+    uint32_t columnCount;
+    uint64_t count;
+    uint64_t columnOffsets[PORTFOLIO_COLUMNS];  // bytes from the start of the file
+};
+
+struct PortfolioHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t instrumentCount;
+    uint64_t kindsOffset;
+    PortfolioSection sections[2];  // stocks, options
+};
+
+static_assert(sizeof(PortfolioSection) == 32 && sizeof(PortfolioHeader) == 96, "portfolio header layout changed");
+static_assert(std::endian::native == std::endian::little, "portfolio files are read and written in host order");
+
+inline uint64_t alignColumn(uint64_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+// A book in the order of kinds with per-instrument factors drawn from seed: priceFactor in
+// [0.5, 2), volatility in [0.05, 1) and commonFactor in [0.25, 0.75).
+inline InstrumentBook samplePortfolioBook(const std::vector<InstrumentKind>& kinds, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    auto uniform = [&](double low, double high) {
+        return low + (high - low) * (static_cast<double>(rng() >> 11) * 0x1.0p-53);
+    };
+    InstrumentBook book;
+    for (InstrumentKind kind : kinds) {
+        if (kind == InstrumentKind::Stock) {
+            book.addStock(uniform(0.5, 2.0), uniform(0.25, 0.75));
+        } else {
+            book.addOption(uniform(0.05, 1.0), uniform(0.25, 0.75));
+        }
+    }
+    return book;
+}
+
+// Writes kinds (book order) and the matching columns of book. Returns false on an I/O error.
+inline bool writePortfolio(const std::string& path, const std::vector<InstrumentKind>& kinds,
+                           const InstrumentBook& book) {
+    const AlignedVector<double>* columns[2][PORTFOLIO_COLUMNS] = {
+        {&book.stocks.priceFactor, &book.stocks.commonFactor},
+        {&book.options.volatility, &book.options.commonFactor}};
+
+    PortfolioHeader header{};
+    std::memcpy(header.magic, PORTFOLIO_MAGIC, sizeof(header.magic));
+    header.version = PORTFOLIO_VERSION;
+    header.sectionCount = 2;
+    header.instrumentCount = kinds.size();
+    header.kindsOffset = alignColumn(sizeof(PortfolioHeader));
+    uint64_t offset = alignColumn(header.kindsOffset + kinds.size());
+    for (uint32_t s = 0; s < 2; ++s) {
+        header.sections[s].kind = s;
+        header.sections[s].columnCount = PORTFOLIO_COLUMNS;
+        header.sections[s].count = columns[s][0]->size();
+        for (uint32_t c = 0; c < PORTFOLIO_COLUMNS; ++c) {
+            header.sections[s].columnOffsets[c] = offset;
+            offset = alignColumn(offset + columns[s][c]->size() * sizeof(double));
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    auto padTo = [&](uint64_t target) {
+        static const char zeros[COLUMN_ALIGNMENT] = {};
+        out.write(zeros, static_cast<std::streamsize>(target - static_cast<uint64_t>(out.tellp())));
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    padTo(header.kindsOffset);
+    out.write(reinterpret_cast<const char*>(kinds.data()), static_cast<std::streamsize>(kinds.size()));
+    for (uint32_t s = 0; s < 2; ++s) {
+        for (uint32_t c = 0; c < PORTFOLIO_COLUMNS; ++c) {
+            padTo(header.sections[s].columnOffsets[c]);
+            out.write(reinterpret_cast<const char*>(columns[s][c]->data()),
+                      static_cast<std::streamsize>(columns[s][c]->size() * sizeof(double)));
+        }
+    }
+    padTo(offset);
+    return static_cast<bool>(out);
+}
+
+// A read-only portfolio file. On POSIX the file is mmap'ed and nothing is copied; elsewhere it is
+// read into one aligned buffer.
+class MappedPortfolio {
+public:
+    MappedPortfolio() = default;
+    MappedPortfolio(const MappedPortfolio&) = delete;
+    MappedPortfolio& operator=(const MappedPortfolio&) = delete;
+    ~MappedPortfolio() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef SPEEDFP_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return fail("cannot open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return fail("cannot stat " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        void* mapping = length ? ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        ::close(fd);
+        if (mapping == MAP_FAILED) return fail("cannot map " + path);
+        base = static_cast<const std::byte*>(mapping);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) return fail("cannot open " + path);
+        length = static_cast<size_t>(in.tellg());
+        buffer.resize((length + sizeof(double) - 1) / sizeof(double));
+        in.seekg(0);
+        if (!in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(length))) {
+            return fail("cannot read " + path);
+        }
+        base = reinterpret_cast<const std::byte*>(buffer.data());
+#endif
+        return validate();
+    }
+
+    void close() {
+#ifdef SPEEDFP_MMAP
+        if (base) ::munmap(const_cast<std::byte*>(base), length);
+#else
+        buffer.clear();
+#endif
+        base = nullptr;
+        length = 0;
+    }
+
+    const std::string& error() const { return message; }
+
+    size_t size() const { return header().instrumentCount; }
+    const InstrumentKind* kinds() const { return at<InstrumentKind>(header().kindsOffset); }
+    size_t stockCount() const { return header().sections[0].count; }
+    size_t optionCount() const { return header().sections[1].count; }
+    const double* stockPriceFactor() const { return column(0, 0); }
+    const double* stockCommonFactor() const { return column(0, 1); }
+    const double* optionVolatility() const { return column(1, 0); }
+    const double* optionCommonFactor() const { return column(1, 1); }
+
+    // Walks the book in file order: makeStock(priceFactor, commonFactor) for stocks and
+    // makeOption(volatility, commonFactor) for options. Used to build any in-memory layout.
+    template <typename MakeStock, typename MakeOption>
+    void forEach(MakeStock makeStock, MakeOption makeOption) const {
+        const InstrumentKind* kind = kinds();
+        size_t stock = 0, option = 0;
+        for (size_t i = 0; i < size(); ++i) {
+            if (kind[i] == InstrumentKind::Stock) {
+                makeStock(stockPriceFactor()[stock], stockCommonFactor()[stock]);
+                ++stock;
+            } else {
+                makeOption(optionVolatility()[option], optionCommonFactor()[option]);
+                ++option;
+            }
+        }
+    }
+
+private:
+    const PortfolioHeader& header() const { return *reinterpret_cast<const PortfolioHeader*>(base); }
+
+    template <typename T>
+    const T* at(uint64_t offset) const { return reinterpret_cast<const T*>(base + offset); }
+
+    const double* column(size_t section, size_t c) const {
+        return at<double>(header().sections[section].columnOffsets[c]);
+    }
+
+    bool fail(const std::string& text) {
+        message = text;
+        close();
+        return false;
+    }
+
+    bool validate() {
+        if (length < sizeof(PortfolioHeader)) return fail("file too short for a portfolio header");
+        const PortfolioHeader& h = header();
+        if (std::memcmp(h.magic, PORTFOLIO_MAGIC, sizeof(h.magic)) != 0) return fail("not a portfolio file");
+        if (h.version != PORTFOLIO_VERSION) return fail("unsupported portfolio version " + std::to_string(h.version));
+        if (h.sectionCount != 2) return fail("unexpected section count");
+        // Bounds checks are written as `count > (length - offset) / size` so that no crafted header
+        // can wrap them around.
+        if (h.kindsOffset > length || h.instrumentCount > length - h.kindsOffset) {
+            return fail("kinds column out of bounds");
+        }
+        for (uint32_t s = 0; s < 2; ++s) {
+            const PortfolioSection& section = h.sections[s];
+            if (section.kind != s || section.columnCount != PORTFOLIO_COLUMNS) return fail("unexpected section layout");
+            for (uint64_t offset : section.columnOffsets) {
+                if (offset % COLUMN_ALIGNMENT != 0) return fail("misaligned column");
+                if (offset > length || section.count > (length - offset) / sizeof(double)) {
+                    return fail("column out of bounds");
+                }
+            }
+        }
+        // forEach() indexes the columns by running counts of each kind, so these must match exactly.
+        const uint8_t* kind = at<uint8_t>(h.kindsOffset);
+        uint64_t stocks = 0;
+        for (uint64_t i = 0; i < h.instrumentCount; ++i) {
+            if (kind[i] > static_cast<uint8_t>(InstrumentKind::Option)) return fail("invalid instrument kind");
+            if (kind[i] == static_cast<uint8_t>(InstrumentKind::Stock)) ++stocks;
+        }
+        if (stocks != h.sections[0].count || h.instrumentCount - stocks != h.sections[1].count) {
+            return fail("section counts do not match the instrument kinds");
+        }
+        return true;
+    }
+
+    const std::byte* base = nullptr;
+    size_t length = 0;
+    std::string message;
+#ifndef SPEEDFP_MMAP
+    AlignedVector<double> buffer;
+#endif
+};
+
+// Prices a mapped portfolio in place, one column at a time, like priceBook().
+inline void pricePortfolio(SimdLevel level, const MappedPortfolio& portfolio, double* stockPrices,
+                           double* optionPrices) {
+    priceColumn(level, portfolio.stockPriceFactor(), portfolio.stockCommonFactor(), STOCK_SCALE, stockPrices,
+                portfolio.stockCount());
+    priceColumn(level, portfolio.optionVolatility(), portfolio.optionCommonFactor(), OPTION_SCALE, optionPrices,
+                portfolio.optionCount());
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include <string>
+
+#include "portfolio_file.h"
+#include "tick_pipeline.h"
+
+// Writes a portfolio file for the startup benchmark or for loading elsewhere:
+//   speedfp_portfolio_gen OUTPUT COUNT [--mix=NAME] [--seed=N] [--ticks=N]
+// COUNT accepts K/M suffixes; the mix and seed mean the same as for speedfp_bench. --ticks also
+// writes OUTPUT.ticks, synthetic market ticks over the same book for --tick-file.
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " OUTPUT COUNT [--mix=NAME] [--seed=N] [--ticks=N]\n"
+              << "  COUNT        instruments, K/M suffixes allowed\n"
+              << "  --mix=NAME   alternating (default), shuffled, skewed or bursty\n"
+              << "  --seed=N     seed for the type mix and instrument factors (default 42)\n"
+              << "  --ticks=N    also write N synthetic market ticks to OUTPUT.ticks\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    std::string output = argv[1];
+    size_t count = parseSize(argv[2]);
+    if (count == 0) {
+        std::cerr << "Invalid instrument count: " << argv[2] << "\n";
+        return 1;
+    }
+
+    TypeMix mix = TypeMix::Alternating;
+    uint64_t seed = DEFAULT_WORKLOAD_SEED;
+    size_t tickCount = 0;
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--mix=", 0) == 0) {
+            if (!parseTypeMix(arg.substr(6), mix) || mix == TypeMix::Replay) {
+                std::cerr << "Unknown mix: " << arg.substr(6) << "\n";
+                return 1;
+            }
+        } else if (arg.rfind("--seed=", 0) == 0) {
+            seed = std::strtoull(arg.c_str() + 7, nullptr, 10);
+        } else if (arg.rfind("--ticks=", 0) == 0) {
+            tickCount = parseSize(arg.substr(8));
+            if (tickCount == 0) {
+                std::cerr << "Invalid tick count: " << arg.substr(8) << "\n";
+                return 1;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    auto kinds = makeTypeSequence(mix, count, seed);
+    if (!writePortfolio(output, kinds, samplePortfolioBook(kinds, seed))) {
+        std::cerr << "Cannot write " << output << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << count << " instruments (" << typeMixName(mix) << ") to " << output << "\n";
+
+    if (tickCount == 0) return 0;
+    if (!writeTickFile(output + ".ticks", syntheticTicks(tickCount, count, seed))) {
+        std::cerr << "Cannot write " << output << ".ticks\n";
+        return 1;
+    }
+    std::cout << "Wrote " << tickCount << " ticks to " << output << ".ticks\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <filesystem>
+#include <variant>
+
+#include "benchmark.h"
+#include "portfolio_file.h"
+
+namespace {
+
+// Startup work is a single pass over the whole book, so it is timed a few times end to end
+// rather than sampled like the pricing loops.
+constexpr size_t STARTUP_RUNS = 3;
+
+class Data {
+public:
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+    double getCommonFactor() const { return commonFactor; }
+protected:
+    explicit Data(double common) : commonFactor(common) {}
+    double commonFactor;
+};
+
+class StockData : public Data {
+public:
+    StockData(double factor, double common) : Data(common), priceFactor(factor) {}
+    double calculatePrice() const override { return priceFactor * STOCK_SCALE + getCommonFactor(); }
+private:
+    double priceFactor;
+};
+
+// The file carries no option contract terms, so every layout here prices options with the
+// two-column formula of pricePortfolio(), whichever option model the build selects.
+class OptionData : public Data {
+public:
+    OptionData(double vol, double common) : Data(common), volatility(vol) {}
+    double calculatePrice() const override { return volatility * OPTION_SCALE + getCommonFactor(); }
+private:
+    double volatility;
+};
+
+// Value types for the variant layout, priced without virtual dispatch.
+struct StockValue {
+    double priceFactor;
+    double commonFactor;
+    double calculatePrice() const { return priceFactor * STOCK_SCALE + commonFactor; }
+};
+
+struct OptionValue {
+    double volatility;
+    double commonFactor;
+    double calculatePrice() const { return volatility * OPTION_SCALE + commonFactor; }
+};
+
+using DataVariant = std::variant<StockValue, OptionValue>;
+
+double priceAll(const std::vector<InstrumentPtr<Data>>& book) {
+    double total = 0;
+    for (const auto& data : book) total += data->calculatePrice();
+    return total;
+}
+
+double priceAll(const std::vector<DataVariant>& book) {
+    double total = 0;
+    for (const auto& data : book) total += std::visit([](const auto& d) { return d.calculatePrice(); }, data);
+    return total;
+}
+
+// Reports a failed open once instead of timing it.
+bool openPortfolio(MappedPortfolio& portfolio, const std::string& path) {
+    if (portfolio.open(path)) return true;
+    std::cerr << "    cannot load " << path << ": " << portfolio.error() << "\n";
+    return false;
+}
+
+// benchmarkOnce over the whole book, plus the wall time it adds up to.
+template <typename Func>
+void benchmarkStartup(const std::string& label, Func func, size_t size) {
+    BenchmarkResult result = benchmarkOnce(label, func, STARTUP_RUNS, size);
+    if (benchmarkOptions().format != OutputFormat::Text) return;
+    std::cout << "    " << result.median * static_cast<double>(size) / 1e6 << " ms to first price\n";
+}
+
+SPEEDFP_DESIGN(portfolio_pricer) {
+    const size_t size = bookSize();
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("speedfp_portfolio_" + std::to_string(size) + ".bin")).string();
+    {
+        auto kinds = workloadTypes(size);
+        if (!writePortfolio(path, kinds, samplePortfolioBook(kinds, benchmarkOptions().seed))) {
+            std::cerr << "    cannot write " << path << "\n";
+            return;
+        }
+    }
+    MappedPortfolio probe;
+    if (!openPortfolio(probe, path)) return;
+    probe.close();
+
+    // Time to first price: everything from an empty process state to one price per instrument.
+    // The constructed books use the fixed factors of the other designs, so they skip the file's
+    // per-instrument values and slightly flatter the current path.
+    benchmarkStartup("Startup: construct unique_ptr book, price", [&](auto stop) {
+        std::vector<InstrumentPtr<Data>> book;
+        book.reserve(size);
+        for (auto kind : workloadTypes(size)) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(makeInstrument<StockData>(1.2, 0.5));
+            } else {
+                book.emplace_back(makeInstrument<OptionData>(0.8, 0.5));
+            }
+        }
+        doNotOptimize(priceAll(book));
+        stop();
+    }, size);
+
+    benchmarkStartup("Startup: construct variant book, price", [&](auto stop) {
+        std::vector<DataVariant> book;
+        book.reserve(size);
+        for (auto kind : workloadTypes(size)) {
+            if (kind == InstrumentKind::Stock) {
+                book.emplace_back(StockValue{1.2, 0.5});
+            } else {
+                book.emplace_back(OptionValue{0.8, 0.5});
+            }
+        }
+        doNotOptimize(priceAll(book));
+        stop();
+    }, size);
+
+    const SimdLevel level = widestSimdLevel();
+    const std::string inPlace = std::string("Startup: mmap file, price in place (") + simdLevelName(level) + ")";
+    benchmarkStartup(inPlace, [&](auto stop) {
+        MappedPortfolio portfolio;
+        if (!openPortfolio(portfolio, path)) return stop();
+        AlignedVector<double> stockPrices(portfolio.stockCount());
+        AlignedVector<double> optionPrices(portfolio.optionCount());
+        pricePortfolio(level, portfolio, stockPrices.data(), optionPrices.data());
+        clobberMemory();
+        stop();
+    }, size);
+
+    benchmarkStartup("Startup: mmap file, materialize unique_ptr book, price", [&](auto stop) {
+        MappedPortfolio portfolio;
+        if (!openPortfolio(portfolio, path)) return stop();
+        std::vector<InstrumentPtr<Data>> book;
+        book.reserve(portfolio.size());
+        portfolio.forEach(
+            [&](double factor, double common) { book.emplace_back(makeInstrument<StockData>(factor, common)); },
+            [&](double vol, double common) { book.emplace_back(makeInstrument<OptionData>(vol, common)); });
+        doNotOptimize(priceAll(book));
+        stop();
+    }, size);
+
+    benchmarkStartup("Startup: mmap file, materialize variant book, price", [&](auto stop) {
+        MappedPortfolio portfolio;
+        if (!openPortfolio(portfolio, path)) return stop();
+        std::vector<DataVariant> book;
+        book.reserve(portfolio.size());
+        portfolio.forEach([&](double factor, double common) { book.emplace_back(StockValue{factor, common}); },
+                          [&](double vol, double common) { book.emplace_back(OptionValue{vol, common}); });
+        doNotOptimize(priceAll(book));
+        stop();
+    }, size);
+
+    if (benchmarkOptions().format == OutputFormat::Text) {
+        std::cout << "    " << std::filesystem::file_size(path) / 1'000'000.0
+                  << " MB file, read from a warm page cache\n";
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace
@@ -0,0 +1,34 @@
+#include "benchmark.h"
+#include "instrument_books.h"
+#include "interleave.h"
+
+namespace {
+
+// How far ahead the prefetching loop touches, and how many coroutines the interleaved loop keeps in
+// flight. The useful values grow with memory latency over per-instrument work.
+constexpr size_t PREFETCH_DISTANCES[] = {2, 8, 32};
+constexpr size_t INTERLEAVE_GROUPS[] = {4, 8, 16};
+
+// The loops of interleave.h over the same unique_ptr book as the tick and service designs.
+SPEEDFP_DESIGN(prefetch_pricer) {
+    books::VirtualBook virtualBook(workloadTypes());
+    const auto& book = virtualBook.instruments();
+
+    benchmark("Pointer chasing: plain loop", [&]() {
+        doNotOptimize(pricePlain(book));
+    }, ITERATIONS);
+
+    for (size_t distance : PREFETCH_DISTANCES) {
+        benchmark("Pointer chasing: prefetch " + std::to_string(distance) + " ahead", [&]() {
+            doNotOptimize(pricePrefetched(book, distance));
+        }, ITERATIONS);
+    }
+
+    for (size_t group : INTERLEAVE_GROUPS) {
+        benchmark("Pointer chasing: " + std::to_string(group) + " interleaved coroutines", [&]() {
+            doNotOptimize(priceInterleaved(book, group));
+        }, ITERATIONS);
+    }
+}
+
+} // namespace
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// Memoization of prices keyed on the exact pricing inputs.
+//
+// A PriceKey packs an instrument kind and up to KEY_INPUTS doubles into a fixed block of 64-bit
+// words, so hashing and comparing are the same straight-line code over eight words for every
+// instrument; the hash runs four independent multiply lanes to keep the multipliers busy.
+//
+// PriceCache is a bounded open-addressing table with linear probing over at most MAX_PROBE slots.
+// Every entry is stamped with the market-data epoch it was priced under; a lookup under any other
+// epoch treats it as empty, so moving the market invalidates the whole cache in O(1). When the
+// probe window is full the home slot is evicted.
+
+constexpr size_t KEY_WORDS = 8;
+constexpr size_t KEY_INPUTS = KEY_WORDS - 1;
+
+struct PriceKey {
+    std::array<uint64_t, KEY_WORDS> words{};
+
+    template <typename... Inputs>
+    static PriceKey of(uint64_t kind, Inputs... inputs) {
+        static_assert(sizeof...(Inputs) <= KEY_INPUTS, "too many pricing inputs for a PriceKey");
+        return {{kind, std::bit_cast<uint64_t>(static_cast<double>(inputs))...}};
+    }
+
+    friend bool operator==(const PriceKey&, const PriceKey&) = default;
+};
+
+// Four independent multiply-xorshift lanes over word pairs (w, w + 4), then a final avalanche.
+inline uint64_t hashPriceKey(const PriceKey& key) {
+    constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    auto mix = [](uint64_t lane, uint64_t word) {
+        uint64_t x = (lane ^ word) * MULTIPLIER;
+        return x ^ (x >> 32);
+    };
+    const auto& w = key.words;
+    uint64_t a = mix(mix(0x243F6A8885A308D3ULL, w[0]), w[4]);
+    uint64_t b = mix(mix(0x13198A2E03707344ULL, w[1]), w[5]);
+    uint64_t c = mix(mix(0xA4093822299F31D0ULL, w[2]), w[6]);
+    uint64_t d = mix(mix(0x082EFA98EC4E6C89ULL, w[3]), w[7]);
+    uint64_t h = a ^ std::rotl(b, 16) ^ std::rotl(c, 32) ^ std::rotl(d, 48);
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 32);
+}
+
+class PriceCache {
+public:
+    static constexpr size_t MAX_PROBE = 8;
+
+    struct Counters {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+    };
+
+    // capacity is rounded up to a power of two.
+    explicit PriceCache(size_t capacity) : slots(std::bit_ceil(std::max<size_t>(capacity, MAX_PROBE))) {}
+
+    // Returns the cached price of key under epoch, or computes it with compute() and caches it.
+    template <typename Compute>
+    double lookup(const PriceKey& key, uint64_t epoch, Compute compute) {
+        uint64_t hash = hashPriceKey(key);
+        size_t mask = slots.size() - 1;
+        size_t home = hash & mask;
+        Slot* free = nullptr;
+        for (size_t probe = 0; probe < MAX_PROBE; ++probe) {
+            Slot& slot = slots[(home + probe) & mask];
+            if (slot.epoch != epoch) {
+                if (!free) free = &slot;
+                continue;
+            }
+            if (slot.hash == hash && slot.key == key) {
+                ++stats.hits;
+                return slot.value;
+            }
+        }
+
+        ++stats.misses;
+        if (!free) {
+            free = &slots[home];
+            ++stats.evictions;
+        }
+        free->hash = hash;
+        free->epoch = epoch;
+        free->key = key;
+        free->value = compute();
+        return free->value;
+    }
+
+    size_t capacity() const { return slots.size(); }
+    const Counters& counters() const { return stats; }
+    void resetCounters() { stats = {}; }
+
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        uint64_t epoch = UINT64_MAX;  // no market epoch reaches this, so new slots start empty
+        PriceKey key;
+        double value = 0;
+    };
+
+    std::vector<Slot> slots;
+    Counters stats;
+};
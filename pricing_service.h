@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "mpmc_queue.h"
+
+// In-process pricing service: any number of client threads submit requests into a bounded MpmcQueue,
+// a pool of worker threads prices them with a shared read-only pricer, and each request completes
+// through its own callback on the worker that priced it. Callbacks rather than futures, so a request
+// is three words in the queue and completing it allocates nothing.
+//
+// The load generator is open loop like the tick pipeline: request i is due at start + i / rate no
+// matter how far behind the service is, and its latency runs from that due time to its completion.
+
+struct PricingRequest {
+    uint32_t instrument;
+    void (*complete)(void* context, double price);
+    void* context;
+};
+
+// Pricer is a callable double(uint32_t instrument) const, safe to call from several threads at once.
+template <typename Pricer>
+class PricingService {
+public:
+    PricingService(const Pricer& pricer, size_t workerCount, size_t queueCapacity)
+        : pricer(pricer), queue(queueCapacity) {
+        for (size_t w = 0; w < workerCount; ++w) workers.emplace_back([this] { work(); });
+    }
+
+    // Prices everything still queued, then joins the workers.
+    ~PricingService() {
+        stopping.store(true, std::memory_order_release);
+        for (auto& worker : workers) worker.join();
+    }
+
+    PricingService(const PricingService&) = delete;
+    PricingService& operator=(const PricingService&) = delete;
+
+    // False when the queue is full; the caller decides whether to retry, shed or block.
+    bool trySubmit(const PricingRequest& request) { return queue.tryPush(request); }
+
+private:
+    // Idle workers yield rather than spin, so clients and workers make progress on a shared core.
+    void work() {
+        PricingRequest request;
+        for (;;) {
+            if (queue.tryPop(request)) {
+                request.complete(request.context, pricer(request.instrument));
+            } else if (stopping.load(std::memory_order_acquire)) {
+                if (!queue.tryPop(request)) return;
+                request.complete(request.context, pricer(request.instrument));
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const Pricer& pricer;
+    MpmcQueue<PricingRequest> queue;
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> workers;
+};
+
+struct ServiceRun {
+    std::vector<double> latencies;  // ns from due time to completion, per request in submission order
+    double checksum = 0;            // sum of the prices returned, to keep the pricer observable
+    double seconds = 0;             // from the first due time until the last completion
+};
+
+// Instruments to request, drawn uniformly from a book of bookSize. Taken from raw mt19937_64 output
+// like the workload mixes, since std distributions differ between standard libraries.
+inline std::vector<uint32_t> serviceRequests(size_t count, size_t bookSize, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<uint32_t> requests(count);
+    for (auto& r : requests) r = static_cast<uint32_t>(rng() % bookSize);
+    return requests;
+}
+
+// Drives a service of workerCount workers with producerCount client threads submitting instruments
+// at ratePerSecond in total (0: as fast as the queue accepts them). Client p submits requests p,
+// p + producerCount, ... so the merged stream keeps the global schedule.
+template <typename Pricer>
+ServiceRun runServiceLoad(const Pricer& pricer, const std::vector<uint32_t>& instruments, double ratePerSecond,
+                          size_t producerCount, size_t workerCount, size_t queueCapacity) {
+    using Clock = std::chrono::steady_clock;
+    struct Pending {
+        Clock::time_point due;
+        double price;
+        double latency;
+        std::atomic<size_t>* completed;
+    };
+
+    std::vector<Pending> pending(instruments.size());
+    std::atomic<size_t> completed{0};
+    auto complete = [](void* context, double price) {
+        auto* p = static_cast<Pending*>(context);
+        p->price = price;
+        p->latency = std::chrono::duration<double, std::nano>(Clock::now() - p->due).count();
+        p->completed->fetch_add(1, std::memory_order_release);
+    };
+
+    ServiceRun run;
+    {
+        PricingService<Pricer> service(pricer, workerCount, queueCapacity);
+        const auto start = Clock::now();
+        const double period = ratePerSecond > 0 ? 1e9 / ratePerSecond : 0;
+        std::vector<std::thread> producers;
+        for (size_t c = 0; c < producerCount; ++c) {
+            producers.emplace_back([&, c] {
+                for (size_t i = c; i < instruments.size(); i += producerCount) {
+                    Pending& p = pending[i];
+                    p.completed = &completed;
+                    p.due = start + std::chrono::nanoseconds(static_cast<int64_t>(period * i));
+                    if (period > 0) {
+                        while (Clock::now() < p.due) std::this_thread::yield();
+                    } else {
+                        p.due = Clock::now();
+                    }
+                    while (!service.trySubmit({instruments[i], complete, &p})) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& producer : producers) producer.join();
+        while (completed.load(std::memory_order_acquire) < instruments.size()) std::this_thread::yield();
+        run.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    run.latencies.reserve(pending.size());
+    for (const auto& p : pending) {
+        run.latencies.push_back(p.latency);
+        run.checksum += p.price;
+    }
+    return run;
+}
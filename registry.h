@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Every design translation unit registers itself with SPEEDFP_DESIGN so one driver can run them all
+// in the same process. Classes in design files live in an anonymous namespace because each file
+// defines its own Data/Pricer hierarchy under the same names.
+struct DesignEntry {
+    std::string name;
+    void (*run)();
+    std::string labelSuffix;  // appended to every result label of the design
+};
+
+inline std::vector<DesignEntry>& designRegistry() {
+    static std::vector<DesignEntry> designs;
+    return designs;
+}
+
+struct DesignRegistrar {
+    DesignRegistrar(const char* name, void (*run)(), const char* labelSuffix) {
+        designRegistry().push_back({name, run, labelSuffix});
+    }
+};
+
+// The virtual designs mark their leaf classes SPEEDFP_FINAL. The build compiles them a second time
+// with SPEEDFP_FINAL_CLASSES, which makes those classes final and registers the copy as
+// "<name>_final", so one binary shows what the compiler devirtualizes once the hierarchy is closed.
+#ifdef SPEEDFP_FINAL_CLASSES
+#define SPEEDFP_FINAL final
+#define SPEEDFP_DESIGN_SUFFIX "_final"
+#define SPEEDFP_LABEL_SUFFIX " (final classes)"
+#else
+#define SPEEDFP_FINAL
+#define SPEEDFP_DESIGN_SUFFIX ""
+#define SPEEDFP_LABEL_SUFFIX ""
+#endif
+
+#define SPEEDFP_DESIGN(name)                                                                        \
+    void speedfp_design_##name();                                                                   \
+    const DesignRegistrar speedfp_registrar_##name(#name SPEEDFP_DESIGN_SUFFIX, &speedfp_design_##name, \
+                                                   SPEEDFP_LABEL_SUFFIX);                           \
+    void speedfp_design_##name()
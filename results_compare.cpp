@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include "results_store.h"
+
+// Compares two stored runs (or `--format=json` outputs) benchmark by benchmark:
+//   speedfp_compare [--threshold=PCT] BASELINE.json CURRENT.json
+// The test runs on repetition medians, so both runs need MIN_COMPARE_REPETITIONS repetitions.
+// Exits 1 when any benchmark regressed past the threshold at p < REGRESSION_ALPHA, 2 on bad input.
+
+int main(int argc, char** argv) {
+    double threshold = DEFAULT_REGRESSION_THRESHOLD;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--threshold=", 0) == 0) {
+            if (!parseThreshold(arg.c_str() + 12, threshold)) {
+                std::cerr << "Invalid threshold: " << arg.substr(12) << "\n";
+                return 2;
+            }
+        } else {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--threshold=PCT] BASELINE.json CURRENT.json\n";
+        return 2;
+    }
+
+    RunInfo info[2];
+    std::vector<BenchmarkResult> results[2];
+    for (int r = 0; r < 2; ++r) {
+        if (!loadRun(paths[r], info[r], results[r])) {
+            std::cerr << "Cannot read results from " << paths[r] << "\n";
+            return 2;
+        }
+        std::cout << (r == 0 ? "Baseline: " : "Current:  ") << paths[r];
+        if (!info[r].commit.empty()) {
+            std::cout << " (commit " << info[r].commit << ", " << info[r].compiler << ", " << info[r].flags << ", "
+                      << info[r].cpu << ", " << info[r].date << ")";
+        }
+        std::cout << "\n";
+    }
+    if (info[0].cpu != info[1].cpu || info[0].compiler != info[1].compiler || info[0].flags != info[1].flags) {
+        std::cout << "Note: the runs differ in CPU, compiler or flags\n";
+    }
+    std::cout << "\n";
+    return compareRuns(std::cout, results[0], results[1], threshold) > 0 ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+
+// Reads `speedfp_bench --format=csv` output back into BenchmarkResults, for the tools that compare
+// runs. Columns are looked up by header name, so files from older builds with fewer columns still
+// load; the per-sample timings are not in the CSV and stay empty.
+
+// Identifies a benchmark across runs: label, workload, book size and any non-default heap setup.
+inline std::string resultKey(const BenchmarkResult& r) {
+    std::string key = r.label + " [" + r.workload + ", " + std::to_string(r.bookSize);
+    if (!r.scatter.empty() && r.scatter != "none") key += ", scatter " + r.scatter;
+    if (!r.allocator.empty() && r.allocator != "malloc") key += ", " + r.allocator;
+    return key + "]";
+}
+
+inline std::vector<std::string> splitCsvLine(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                fields.back() += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else if (c != '\r') {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+inline bool readResultsCsv(const std::string& path, std::vector<BenchmarkResult>& results) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) return false;
+    std::map<std::string, size_t> column;
+    auto header = splitCsvLine(line);
+    for (size_t c = 0; c < header.size(); ++c) column[header[c]] = c;
+    for (const char* required : {"design", "workload", "book_size", "label", "median_ns"}) {
+        if (!column.count(required)) return false;
+    }
+
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        auto fields = splitCsvLine(line);
+        auto text = [&](const char* name) -> std::string {
+            auto it = column.find(name);
+            return it != column.end() && it->second < fields.size() ? fields[it->second] : std::string();
+        };
+        auto number = [&](const char* name) {
+            std::string value = text(name);
+            return value.empty() ? 0.0 : std::strtod(value.c_str(), nullptr);
+        };
+
+        BenchmarkResult result;
+        result.design = text("design");
+        result.workload = text("workload");
+        result.bookSize = static_cast<size_t>(number("book_size"));
+        result.scatter = text("scatter");
+        result.allocator = text("allocator");
+        result.label = text("label");
+        result.repetition = static_cast<size_t>(number("repetition"));
+        result.median = number("median_ns");
+        result.min = number("min_ns");
+        result.p90 = number("p90_ns");
+        result.p99 = number("p99_ns");
+        result.mean = number("mean_ns");
+        result.ci95 = number("ci95_ns");
+        result.stddev = number("stddev_ns");
+        result.noisy = text("noisy") == "1";
+        results.push_back(result);
+    }
+    return true;
+}
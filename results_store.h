@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+#include "benchmark.h"
+#include "results_csv.h"
+
+// Stored runs for regression tracking. A run is one JSON file holding the build and machine it came
+// from plus every result with its per-sample timings; `speedfp_bench --save=DIR` writes one, and
+// `--baseline=FILE` (or `speedfp_compare`) diffs a run against a stored one sample by sample.
+
+#ifndef SPEEDFP_GIT_COMMIT
+#define SPEEDFP_GIT_COMMIT "unknown"
+#endif
+#ifndef SPEEDFP_BUILD_FLAGS
+#define SPEEDFP_BUILD_FLAGS "unknown"
+#endif
+
+// Significance level of the Mann-Whitney test that a slowdown past the threshold must also pass.
+constexpr double REGRESSION_ALPHA = 0.01;
+
+// The samples of one repetition share its warmup, book and machine state, so they are not
+// independent draws. The test runs on one median per repetition instead, and needs this many
+// repetitions on each side; at 5 against 5 the smallest two-sided exact p is 2/252 < 0.01.
+constexpr size_t MIN_COMPARE_REPETITIONS = 5;
+
+struct RunInfo {
+    std::string commit;
+    std::string compiler;
+    std::string flags;
+    std::string cpu;
+    std::string date;
+};
+
+inline std::string compilerName() {
+#if defined(__clang__)
+    return "clang " + std::to_string(__clang_major__) + "." + std::to_string(__clang_minor__) + "." +
+           std::to_string(__clang_patchlevel__);
+#elif defined(__GNUC__)
+    return "gcc " + std::to_string(__GNUC__) + "." + std::to_string(__GNUC_MINOR__) + "." +
+           std::to_string(__GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+    return "unknown";
+#endif
+}
+
+inline std::string cpuModel() {
+#if defined(__linux__)
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    for (std::string line; std::getline(cpuinfo, line);) {
+        if (line.rfind("model name", 0) != 0) continue;
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+    }
+#elif defined(__APPLE__)
+    char brand[256];
+    size_t length = sizeof(brand);
+    if (sysctlbyname("machdep.cpu.brand_string", brand, &length, nullptr, 0) == 0) return brand;
+#endif
+    return "unknown";
+}
+
+inline RunInfo currentRunInfo() {
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return {SPEEDFP_GIT_COMMIT, compilerName(), SPEEDFP_BUILD_FLAGS, cpuModel(), date};
+}
+
+// <commit>_<compiler>_<cpu>_<flags hash>.json, so runs of the same build on the same machine replace
+// each other and anything else gets its own file.
+inline std::string storeFileName(const RunInfo& info) {
+    auto clean = [](const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            bool keep = std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '-';
+            if (keep) out += c;
+            else if (!out.empty() && out.back() != '-') out += '-';
+        }
+        while (!out.empty() && out.back() == '-') out.pop_back();
+        return out.empty() ? std::string("unknown") : out;
+    };
+    uint64_t hash = 14695981039346656037ull;  // FNV-1a
+    for (char c : info.flags) hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    char flagsHash[9];
+    std::snprintf(flagsHash, sizeof(flagsHash), "%08x", static_cast<unsigned>(hash ^ (hash >> 32)));
+    return clean(info.commit) + "_" + clean(info.compiler) + "_" + clean(info.cpu) + "_" + flagsHash + ".json";
+}
+
+inline std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+// The `--format=json` array; samples are written at full precision so a stored run compares exactly.
+inline void writeResultsJson(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        out << "  {\"design\": \"" << jsonEscape(r.design) << "\", \"workload\": \"" << r.workload
+            << "\", \"book_size\": " << r.bookSize << ", \"scatter\": \"" << r.scatter
+            << "\", \"allocator\": \"" << r.allocator
+            << "\", \"label\": \"" << jsonEscape(r.label)
+            << "\", \"repetition\": " << r.repetition << ", \"median\": " << r.median << ", \"min\": " << r.min
+            << ", \"p90\": " << r.p90;
+        if (r.samples.size() >= MIN_P99_SAMPLES) out << ", \"p99\": " << r.p99;  // absent below that
+        out << ", \"mean\": " << r.mean
+            << ", \"ci95\": " << r.ci95 << ", \"stddev\": " << r.stddev
+            << ", \"noisy\": " << (r.noisy ? "true" : "false") << ", \"counters\": {";
+        for (size_t c = 0; c < r.counters.size(); ++c) {
+            out << (c ? ", " : "") << "\"" << r.counters[c].first << "\": " << r.counters[c].second;
+        }
+        out << "}, \"samples\": [";
+        std::streamsize precision = out.precision(9);
+        for (size_t s = 0; s < r.samples.size(); ++s) {
+            out << (s ? ", " : "") << r.samples[s];
+        }
+        out.precision(precision);
+        out << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "]";
+}
+
+inline bool saveRun(const std::string& path, const RunInfo& info, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path);
+    out << "{\"commit\": \"" << jsonEscape(info.commit) << "\", \"compiler\": \"" << jsonEscape(info.compiler)
+        << "\", \"flags\": \"" << jsonEscape(info.flags) << "\", \"cpu\": \"" << jsonEscape(info.cpu)
+        << "\", \"date\": \"" << info.date << "\",\n\"results\": ";
+    writeResultsJson(out, results);
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+// Just enough JSON to read back what writeResultsJson and saveRun produce. Objects keep their keys
+// in `keys`, parallel to `items`.
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0;
+    std::string text;
+    std::vector<std::string> keys;
+    std::vector<JsonValue> items;
+
+    const JsonValue* find(const std::string& key) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) return &items[i];
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : text(text) {}
+
+    bool parse(JsonValue& value) { return parseValue(value) && (skipSpace(), pos == text.size()); }
+
+private:
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) ++pos;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != c) return false;
+        ++pos;
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\' && pos < text.size()) {
+                char e = text[pos++];
+                c = e == 'n' ? '\n' : e == 't' ? '\t' : e == 'r' ? '\r' : e;
+            }
+            out += c;
+        }
+        return consume('"');
+    }
+
+    bool parseValue(JsonValue& value) {
+        skipSpace();
+        if (pos >= text.size()) return false;
+        char c = text[pos];
+        if (c == '{') {
+            value.type = JsonValue::Type::Object;
+            ++pos;
+            if (consume('}')) return true;
+            do {
+                value.keys.emplace_back();
+                value.items.emplace_back();
+                if (!parseString(value.keys.back()) || !consume(':') || !parseValue(value.items.back())) return false;
+            } while (consume(','));
+            return consume('}');
+        }
+        if (c == '[') {
+            value.type = JsonValue::Type::Array;
+            ++pos;
+            if (consume(']')) return true;
+            do {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back())) return false;
+            } while (consume(','));
+            return consume(']');
+        }
+        if (c == '"') {
+            value.type = JsonValue::Type::String;
+            return parseString(value.text);
+        }
+        for (const char* literal : {"true", "false", "null"}) {
+            if (text.compare(pos, std::strlen(literal), literal) == 0) {
+                value.type = literal[0] == 'n' ? JsonValue::Type::Null : JsonValue::Type::Bool;
+                value.boolean = literal[0] == 't';
+                pos += std::strlen(literal);
+                return true;
+            }
+        }
+        // strtod also takes the nan and inf that iostreams print for degenerate statistics
+        const char* start = text.c_str() + pos;
+        char* end = nullptr;
+        value.type = JsonValue::Type::Number;
+        value.number = std::strtod(start, &end);
+        pos += end - start;
+        return end != start;
+    }
+
+    const std::string& text;
+    size_t pos = 0;
+};
+
+// Reads a file written by saveRun, or a bare `--format=json` array (whose RunInfo stays empty).
+inline bool loadRun(const std::string& path, RunInfo& info, std::vector<BenchmarkResult>& results) {
+    std::ifstream in(path);
+    if (!in) return false;
+    std::stringstream contents;
+    contents << in.rdbuf();
+    JsonValue root;
+    if (!JsonParser(contents.str()).parse(root)) return false;
+
+    const JsonValue* array = &root;
+    if (root.type == JsonValue::Type::Object) {
+        auto field = [&](const char* key) {
+            const JsonValue* v = root.find(key);
+            return v ? v->text : std::string();
+        };
+        info = {field("commit"), field("compiler"), field("flags"), field("cpu"), field("date")};
+        array = root.find("results");
+    }
+    if (array == nullptr || array->type != JsonValue::Type::Array) return false;
+
+    for (const JsonValue& item : array->items) {
+        auto text = [&](const char* key) {
+            const JsonValue* v = item.find(key);
+            return v ? v->text : std::string();
+        };
+        auto number = [&](const char* key) {
+            const JsonValue* v = item.find(key);
+            return v ? v->number : 0.0;
+        };
+        BenchmarkResult result;
+        result.design = text("design");
+        result.workload = text("workload");
+        result.bookSize = static_cast<size_t>(number("book_size"));
+        result.scatter = text("scatter");
+        result.allocator = text("allocator");
+        result.label = text("label");
+        result.repetition = static_cast<size_t>(number("repetition"));
+        result.median = number("median");
+        result.min = number("min");
+        result.p90 = number("p90");
+        result.p99 = number("p99");
+        result.mean = number("mean");
+        result.ci95 = number("ci95");
+        result.stddev = number("stddev");
+        const JsonValue* noisy = item.find("noisy");
+        result.noisy = noisy && noisy->boolean;
+        if (const JsonValue* counters = item.find("counters")) {
+            for (size_t c = 0; c < counters->keys.size(); ++c) {
+                result.counters.emplace_back(counters->keys[c], counters->items[c].number);
+            }
+        }
+        if (const JsonValue* samples = item.find("samples")) {
+            for (const JsonValue& sample : samples->items) result.samples.push_back(sample.number);
+        }
+        results.push_back(result);
+    }
+    return true;
+}
+
+// Two-sided Mann-Whitney U test. Exact when there are no ties, which is the usual case for
+// repetition medians; otherwise the normal approximation, tie and continuity corrected. Returns the
+// p-value.
+inline double mannWhitneyP(const std::vector<double>& a, const std::vector<double>& b) {
+    size_t n1 = a.size(), n2 = b.size(), n = n1 + n2;
+    if (n1 == 0 || n2 == 0) return 1;
+    std::vector<std::pair<double, bool>> pooled;  // value, from a
+    for (double x : a) pooled.emplace_back(x, true);
+    for (double x : b) pooled.emplace_back(x, false);
+    std::sort(pooled.begin(), pooled.end());
+
+    double rankSumA = 0, ties = 0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && pooled[j].first == pooled[i].first) ++j;
+        double rank = (i + 1 + j) / 2.0;  // average of ranks i+1 .. j
+        for (size_t k = i; k < j; ++k) {
+            if (pooled[k].second) rankSumA += rank;
+        }
+        double t = static_cast<double>(j - i);
+        ties += t * t * t - t;
+        i = j;
+    }
+
+    double u = rankSumA - n1 * (n1 + 1) / 2.0;
+    if (ties == 0) {
+        // ways[j][v]: orderings of the first positions holding j values of a with U = v. The j-th
+        // value of a at position i (1-based) lies above i - j values of b.
+        size_t maxU = n1 * n2;
+        std::vector<std::vector<double>> ways(n1 + 1, std::vector<double>(maxU + 1, 0));
+        ways[0][0] = 1;
+        for (size_t i = 1; i <= n; ++i) {
+            for (size_t j = std::min(i, n1); j >= 1; --j) {
+                if (i - j > n2) break;
+                for (size_t v = i - j; v <= maxU; ++v) ways[j][v] += ways[j - 1][v - (i - j)];
+            }
+        }
+        double total = 0, below = 0, above = 0;
+        for (size_t v = 0; v <= maxU; ++v) {
+            total += ways[n1][v];
+            if (v <= u) below += ways[n1][v];
+            if (v >= u) above += ways[n1][v];
+        }
+        return std::min(1.0, 2 * std::min(below, above) / total);
+    }
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - ties / (static_cast<double>(n) * (n - 1)));
+    if (variance <= 0) return 1;
+    double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+// The median of every repetition of each benchmark, in repetition order.
+inline std::map<std::string, std::vector<double>> repetitionMedians(const std::vector<BenchmarkResult>& results,
+                                                                    std::vector<std::string>& order) {
+    std::map<std::string, std::vector<double>> medians;
+    for (const auto& r : results) {
+        std::string key = resultKey(r);
+        if (!medians.count(key)) order.push_back(key);
+        medians[key].push_back(r.median);
+    }
+    return medians;
+}
+
+// `--threshold=` values: a non-negative percentage, stored as a fraction. False when malformed.
+inline bool parseThreshold(const char* text, double& threshold) {
+    char* end = nullptr;
+    double percent = std::strtod(text, &end);
+    if (end == text || *end != '\0' || !(percent >= 0) || !std::isfinite(percent)) return false;
+    threshold = percent / 100;
+    return true;
+}
+
+// Prints one line per benchmark present in both runs and returns the number of regressions: the
+// median of the repetition medians slower by more than `threshold` of the baseline's, and the
+// medians significantly different at REGRESSION_ALPHA. Benchmarks with fewer than
+// MIN_COMPARE_REPETITIONS repetitions on either side are listed but not tested.
+inline size_t compareRuns(std::ostream& out, const std::vector<BenchmarkResult>& baseline,
+                          const std::vector<BenchmarkResult>& current, double threshold) {
+    std::vector<std::string> baseOrder, order;
+    auto before = repetitionMedians(baseline, baseOrder);
+    auto after = repetitionMedians(current, order);
+
+    size_t regressions = 0, compared = 0, untested = 0;
+    out << std::fixed << std::setprecision(3);
+    for (const auto& key : order) {
+        auto base = before.find(key);
+        if (base == before.end()) continue;
+        std::vector<double> a = base->second, b = after[key];
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        double baseMedian = percentile(a, 0.5), median = percentile(b, 0.5);
+        double change = baseMedian > 0 ? (median - baseMedian) / baseMedian : 0;
+        out << key << ": " << baseMedian << " -> " << median << " ns/iter (" << std::showpos << change * 100
+            << std::noshowpos << "%";
+        if (a.size() < MIN_COMPARE_REPETITIONS || b.size() < MIN_COMPARE_REPETITIONS) {
+            ++untested;
+            out << ", untested: " << a.size() << " and " << b.size() << " repetitions)\n";
+            continue;
+        }
+        ++compared;
+        double p = mannWhitneyP(a, b);
+        bool significant = p < REGRESSION_ALPHA;
+        const char* verdict = !significant ? "" : change > threshold ? "  REGRESSION"
+                            : change < -threshold ? "  improved" : "";
+        if (significant && change > threshold) ++regressions;
+        out << ", p=" << std::setprecision(4) << p << std::setprecision(3) << ")" << verdict << "\n";
+    }
+    out << std::defaultfloat << std::setprecision(6);
+    out << compared << " benchmarks compared, " << regressions << " regressed by more than " << threshold * 100
+        << "% at p<" << REGRESSION_ALPHA << "\n";
+    if (untested > 0) {
+        out << untested << " benchmarks untested: they need " << MIN_COMPARE_REPETITIONS
+            << " repetitions per run (--repetitions=" << MIN_COMPARE_REPETITIONS << ")\n";
+    }
+    return regressions;
+}
@@ -0,0 +1,78 @@
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "results_csv.h"
+
+// Joins CSV results from several builds into one Markdown table of medians:
+//   speedfp_table [--title=TEXT] NAME=results.csv [NAME=results.csv ...]
+// One row per benchmark (label, workload, book size, allocator), one column per NAME. With
+// repetitions, a cell is the median of the repetition medians; '*' marks a noisy result.
+
+namespace {
+
+struct Cell {
+    std::vector<double> medians;
+    bool noisy = false;
+};
+
+std::string formatCell(Cell cell) {
+    if (cell.medians.empty()) return "-";
+    std::sort(cell.medians.begin(), cell.medians.end());
+    std::ostringstream text;
+    text << std::setprecision(4) << percentile(cell.medians, 0.5) << (cell.noisy ? "*" : "");
+    return text.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string title;
+    std::vector<std::string> columns;
+    std::vector<std::string> rows;
+    std::map<std::string, std::map<std::string, Cell>> cells;  // row, column
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--title=", 0) == 0) {
+            title = arg.substr(8);
+            continue;
+        }
+        size_t equals = arg.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << "Usage: " << argv[0] << " [--title=TEXT] NAME=results.csv [NAME=results.csv ...]\n";
+            return 1;
+        }
+        std::string name = arg.substr(0, equals);
+        std::vector<BenchmarkResult> results;
+        if (!readResultsCsv(arg.substr(equals + 1), results)) {
+            std::cerr << "Cannot read results from " << arg.substr(equals + 1) << "\n";
+            return 1;
+        }
+        columns.push_back(name);
+        for (const auto& result : results) {
+            std::string key = resultKey(result);
+            if (!cells.count(key)) rows.push_back(key);
+            Cell& cell = cells[key][name];
+            cell.medians.push_back(result.median);
+            cell.noisy = cell.noisy || result.noisy;
+        }
+    }
+    if (columns.empty()) {
+        std::cerr << "No result files given\n";
+        return 1;
+    }
+
+    if (!title.empty()) std::cout << "### " << title << "\n\n";
+    std::cout << "| Benchmark (median ns/iter) |";
+    for (const auto& column : columns) std::cout << " " << column << " |";
+    std::cout << "\n|---|";
+    for (size_t c = 0; c < columns.size(); ++c) std::cout << "---:|";
+    std::cout << "\n";
+    for (const auto& row : rows) {
+        std::cout << "| " << row << " |";
+        for (const auto& column : columns) std::cout << " " << formatCell(cells[row][column]) << " |";
+        std::cout << "\n";
+    }
+    return 0;
+}
@@ -1 +1 @@
-Get-ChildItem -Path ".\build\Release\" -Filter "*.exe" | ForEach-Object { & $_.FullName }
\ No newline at end of file
+& ".\build\Release\speedfp_bench.exe" @args
@@ -4,17 +4,6 @@
 mkdir -p build && cd build
 cmake .. && make -j$(nproc)
 
-# Run in specified order
-./virtual_function
-./virtual_pricer
-./fat_interface
-./fat_interface_pricer
-./crtp
-./crtp_pricer
-./derived_pricer_no_virtual
-./derived_pricer_with_virtual_used
-./derived_pricer_with_virtual_unused
-./dynamic_cast_pricer
-./static_cast_pricer
-./dynamic_subpricer
-./static_subpricer 
\ No newline at end of file
+# Run every registered design in one process, in registration order.
+# Extra arguments are forwarded, e.g. --filter=cast --repetitions=5 --format=json
+./speedfp_bench "$@"
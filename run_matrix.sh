@@ -0,0 +1,62 @@
+#!/bin/bash
+
+# Builds every design under each build configuration of CMakePresets.json, runs it, and prints one
+# consolidated Markdown table per compiler (results/<compiler>.md).
+#
+# Usage: ./run_matrix.sh [--compilers="g++ clang++"] [--configs="o2 o3 pgo"] [speedfp_bench args...]
+#   configs: o1 o2 o3 o3-native o3-lto o3-thinlto pgo (default: all; o3-thinlto only for Clang)
+#   pgo builds the instrumented pgo-generate preset, trains it by running the same benchmark, then
+#   rebuilds the same directory with pgo-use.
+# Extra arguments go to every speedfp_bench run, e.g. --filter=virtual --mix=shuffled.
+
+cd "$(dirname "$0")"
+COMPILERS="c++"
+CONFIGS="o1 o2 o3 o3-native o3-lto o3-thinlto pgo"
+BENCH_ARGS=()
+for arg in "$@"; do
+    case "$arg" in
+        --compilers=*) COMPILERS="${arg#--compilers=}" ;;
+        --configs=*) CONFIGS="${arg#--configs=}" ;;
+        *) BENCH_ARGS+=("$arg") ;;
+    esac
+done
+
+build() {  # preset build-dir compiler
+    cmake --preset "$1" -B "$2" -DCMAKE_CXX_COMPILER="$3" > "$2.configure.log" 2>&1 &&
+        cmake --build "$2" --target speedfp_bench speedfp_table -j"$(nproc 2>/dev/null || echo 4)" > "$2.build.log" 2>&1
+}
+
+mkdir -p results
+for COMPILER in $COMPILERS; do
+    NAME=$(basename "$COMPILER")
+    ROOT="build/matrix/$NAME"
+    mkdir -p "$ROOT" "results/$NAME"
+    IS_CLANG=$("$COMPILER" --version 2>/dev/null | grep -qi clang && echo 1)
+    COLUMNS=()
+    TABLE_TOOL=""
+
+    for CONFIG in $CONFIGS; do
+        if [ "$CONFIG" = "o3-thinlto" ] && [ -z "$IS_CLANG" ]; then continue; fi
+        DIR="$ROOT/$CONFIG"
+        echo "== $NAME $CONFIG" >&2
+        if [ "$CONFIG" = "pgo" ]; then
+            rm -rf "$DIR/pgo-profile"
+            build pgo-generate "$DIR" "$COMPILER" || { echo "   build failed, see $DIR.build.log" >&2; continue; }
+            "$DIR/speedfp_bench" "${BENCH_ARGS[@]}" > /dev/null
+            if [ -n "$IS_CLANG" ]; then
+                llvm-profdata merge -o "$DIR/pgo-profile/speedfp.profdata" "$DIR"/pgo-profile/*.profraw || continue
+            fi
+            build pgo-use "$DIR" "$COMPILER" || { echo "   build failed, see $DIR.build.log" >&2; continue; }
+        else
+            build "$CONFIG" "$DIR" "$COMPILER" || { echo "   build failed, see $DIR.build.log" >&2; continue; }
+        fi
+        "$DIR/speedfp_bench" "${BENCH_ARGS[@]}" --format=csv > "results/$NAME/$CONFIG.csv" || continue
+        COLUMNS+=("$CONFIG=results/$NAME/$CONFIG.csv")
+        TABLE_TOOL="$DIR/speedfp_table"
+    done
+
+    if [ -n "$TABLE_TOOL" ]; then
+        "$TABLE_TOOL" --title="$NAME ($("$COMPILER" --version | head -n 1))" "${COLUMNS[@]}" > "results/$NAME.md"
+        cat "results/$NAME.md"
+    fi
+done
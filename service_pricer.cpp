@@ -0,0 +1,40 @@
+#include "benchmark.h"
+#include "instrument_books.h"
+#include "latency_report.h"
+#include "pricing_service.h"
+
+namespace {
+
+constexpr size_t SERVICE_REQUESTS = 50'000;
+constexpr size_t SERVICE_QUEUE_CAPACITY = 4096;
+constexpr size_t SERVICE_PRODUCERS = 2;
+constexpr size_t SERVICE_WORKERS = 2;  // unless --threads gives the worker counts
+
+// Service pricers: each design keeps its own book (instrument_books.h) and prices one instrument by
+// id. The books are only read once built, so every worker shares the same one.
+
+template <typename Book>
+void serve(const std::string& design, const std::vector<uint32_t>& requests, const Book& book) {
+    std::vector<size_t> workerCounts = benchmarkOptions().threads;
+    if (workerCounts.empty()) workerCounts = {SERVICE_WORKERS};
+    for (size_t workers : workerCounts) {
+        for (size_t rate : benchmarkOptions().serviceRates) {
+            ServiceRun run = runServiceLoad(book, requests, static_cast<double>(rate), SERVICE_PRODUCERS, workers,
+                                            SERVICE_QUEUE_CAPACITY);
+            reportLatencyRun("Pricing service: " + design + ", " + std::to_string(workers) + " workers, " +
+                             rateName(rate, "req/s", "saturation"), run, "request-to-price", "req/s completed");
+        }
+    }
+}
+
+SPEEDFP_DESIGN(service_pricer) {
+    auto kinds = workloadTypes();
+    auto requests = serviceRequests(SERVICE_REQUESTS, kinds.size(), benchmarkOptions().seed);
+
+    serve("virtual Data", requests, books::VirtualBook(kinds));
+    serve("Data with plug-in Pricer", requests, books::PluginBook(kinds));
+    serve("std::variant", requests, books::VariantBook(kinds));
+    serve("SoA book", requests, books::SoaBook(kinds));
+}
+
+} // namespace
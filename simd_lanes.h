@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// AVX2 and AVX-512 lane types for the generic kernels in vector_math.h. They are only defined in
+// translation units compiled for that instruction set (see the *_avx2.cpp / *_avx512.cpp files),
+// which are called through runtime dispatch. Those files should instantiate templates with these
+// lane types only: an inline function shared with the scalar build could otherwise be emitted with
+// AVX instructions and picked by the linker for the scalar path.
+
+#ifdef __AVX2__
+
+struct Avx2Lane {
+    static constexpr size_t WIDTH = 4;
+    __m256d v;
+
+    static Avx2Lane load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+
+    static Avx2Lane splat(double x) { return {_mm256_set1_pd(x)}; }
+    friend Avx2Lane operator+(Avx2Lane a, Avx2Lane b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend Avx2Lane operator-(Avx2Lane a, Avx2Lane b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend Avx2Lane operator*(Avx2Lane a, Avx2Lane b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend Avx2Lane operator/(Avx2Lane a, Avx2Lane b) { return {_mm256_div_pd(a.v, b.v)}; }
+    static Avx2Lane sqrt(Avx2Lane a) { return {_mm256_sqrt_pd(a.v)}; }
+    static Avx2Lane abs(Avx2Lane a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+    static Avx2Lane min(Avx2Lane a, Avx2Lane b) { return {_mm256_min_pd(a.v, b.v)}; }
+    static Avx2Lane max(Avx2Lane a, Avx2Lane b) { return {_mm256_max_pd(a.v, b.v)}; }
+    static Avx2Lane round(Avx2Lane a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+    // AVX2 has no double <-> int64 conversion; adding 1.5 * 2^52 leaves the integer in the low mantissa bits.
+    static Avx2Lane pow2(Avx2Lane n) {
+        const __m256d magic = _mm256_set1_pd(0x1.8p52);
+        __m256i integer = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(n.v, magic)), _mm256_castpd_si256(magic));
+        return {_mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(integer, _mm256_set1_epi64x(1023)), 52))};
+    }
+
+    static Avx2Lane frexp(Avx2Lane x, Avx2Lane& exponent) {
+        const __m256d twoTo52 = _mm256_set1_pd(0x1p52);
+        __m256i bits = _mm256_castpd_si256(x.v);
+        __m256i biased = _mm256_and_si256(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(0x7ff));
+        __m256d asDouble = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_castpd_si256(twoTo52))), twoTo52);
+        exponent.v = _mm256_sub_pd(asDouble, _mm256_set1_pd(1022.0));
+        __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL));
+        return {_mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3fe0000000000000LL)))};
+    }
+
+    static Avx2Lane selectLess(Avx2Lane a, Avx2Lane b, Avx2Lane ifLess, Avx2Lane otherwise) {
+        return {_mm256_blendv_pd(otherwise.v, ifLess.v, _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ))};
+    }
+};
+
+#endif
+
+#ifdef __AVX512F__
+
+struct Avx512Lane {
+    static constexpr size_t WIDTH = 8;
+    __m512d v;
+
+    static Avx512Lane load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+
+    static Avx512Lane splat(double x) { return {_mm512_set1_pd(x)}; }
+    friend Avx512Lane operator+(Avx512Lane a, Avx512Lane b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend Avx512Lane operator-(Avx512Lane a, Avx512Lane b) { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend Avx512Lane operator*(Avx512Lane a, Avx512Lane b) { return {_mm512_mul_pd(a.v, b.v)}; }
+    friend Avx512Lane operator/(Avx512Lane a, Avx512Lane b) { return {_mm512_div_pd(a.v, b.v)}; }
+    static Avx512Lane sqrt(Avx512Lane a) { return {_mm512_sqrt_pd(a.v)}; }
+    static Avx512Lane abs(Avx512Lane a) { return {_mm512_abs_pd(a.v)}; }
+    static Avx512Lane min(Avx512Lane a, Avx512Lane b) { return {_mm512_min_pd(a.v, b.v)}; }
+    static Avx512Lane max(Avx512Lane a, Avx512Lane b) { return {_mm512_max_pd(a.v, b.v)}; }
+    static Avx512Lane round(Avx512Lane a) { return {_mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+
+    // Same magic-number conversion as Avx2Lane, to stay within AVX-512F (no DQ needed).
+    static Avx512Lane pow2(Avx512Lane n) {
+        const __m512d magic = _mm512_set1_pd(0x1.8p52);
+        __m512i integer = _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(n.v, magic)), _mm512_castpd_si512(magic));
+        return {_mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(integer, _mm512_set1_epi64(1023)), 52))};
+    }
+
+    static Avx512Lane frexp(Avx512Lane x, Avx512Lane& exponent) {
+        const __m512d twoTo52 = _mm512_set1_pd(0x1p52);
+        __m512i bits = _mm512_castpd_si512(x.v);
+        __m512i biased = _mm512_and_si512(_mm512_srli_epi64(bits, 52), _mm512_set1_epi64(0x7ff));
+        __m512d asDouble = _mm512_sub_pd(_mm512_castsi512_pd(_mm512_or_si512(biased, _mm512_castpd_si512(twoTo52))), twoTo52);
+        exponent.v = _mm512_sub_pd(asDouble, _mm512_set1_pd(1022.0));
+        __m512i mantissa = _mm512_and_si512(bits, _mm512_set1_epi64(0x000fffffffffffffLL));
+        return {_mm512_castsi512_pd(_mm512_or_si512(mantissa, _mm512_set1_epi64(0x3fe0000000000000LL)))};
+    }
+
+    static Avx512Lane selectLess(Avx512Lane a, Avx512Lane b, Avx512Lane ifLess, Avx512Lane otherwise) {
+        return {_mm512_mask_blend_pd(_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ), otherwise.v, ifLess.v)};
+    }
+};
+
+#endif
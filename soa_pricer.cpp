@@ -0,0 +1,28 @@
+#include "benchmark.h"
+#include "instrument_book.h"
+
+namespace {
+
+SPEEDFP_DESIGN(soa_pricer) {
+    InstrumentBook book;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            book.addStock(1.2);
+        } else {
+            book.addOption(0.8, 0.5, optionContract(book.options.volatility.size()));
+        }
+    }
+
+    AlignedVector<double> stockPrices(book.stocks.priceFactor.size());
+    AlignedVector<double> optionPrices(book.options.volatility.size());
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (!simdLevelSupported(level)) continue;
+        benchmark(std::string("Design: SoA book, ") + simdLevelName(level) + " kernel", [&]() {
+            priceBook(level, book, stockPrices.data(), optionPrices.data());
+            clobberMemory();
+        }, ITERATIONS);
+    }
+}
+
+} // namespace
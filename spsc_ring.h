@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <vector>
+
+#include "instrument_book.h"
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread. Head and tail
+// live on their own cache lines, and each side keeps a private copy of the other's index so it
+// only touches the shared line when the ring looks full (producer) or empty (consumer).
+template <typename T>
+class SpscRing {
+public:
+    // capacity is rounded up to a power of two.
+    explicit SpscRing(size_t capacity)
+        : slots(std::bit_ceil(std::max<size_t>(capacity, 2))), mask(slots.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer side; false when the ring is full.
+    bool tryPush(const T& value) {
+        size_t tail = producer.index.load(std::memory_order_relaxed);
+        if (tail - producer.cachedOther == slots.size()) {
+            producer.cachedOther = consumer.index.load(std::memory_order_acquire);
+            if (tail - producer.cachedOther == slots.size()) return false;
+        }
+        slots[tail & mask] = value;
+        producer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when the ring is empty.
+    bool tryPop(T& value) {
+        size_t head = consumer.index.load(std::memory_order_relaxed);
+        if (head == consumer.cachedOther) {
+            consumer.cachedOther = producer.index.load(std::memory_order_acquire);
+            if (head == consumer.cachedOther) return false;
+        }
+        value = slots[head & mask];
+        consumer.index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return slots.size(); }
+
+private:
+    struct alignas(COLUMN_ALIGNMENT) Side {
+        std::atomic<size_t> index{0};
+        size_t cachedOther = 0;  // last index seen from the other side
+    };
+
+    std::vector<T> slots;
+    size_t mask;
+    Side producer;  // tail: next slot to write
+    Side consumer;  // head: next slot to read
+};
@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class Data {
 public:
@@ -9,18 +12,19 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData() : priceFactor(1.2) {}
     bool isStock() const override { return true; }
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData() : volatility(0.8) {}
+    explicit OptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
     bool isStock() const override { return false; }
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class StaticPricer {
@@ -29,23 +33,32 @@ public:
         if (data->isStock()) {
             return static_cast<const StockData*>(data)->priceFactor * 1.1 + data->getCommonFactor();
         }
-        return static_cast<const OptionData*>(data)->volatility * 2.5 + data->getCommonFactor();
+        const auto* option = static_cast<const OptionData*>(data);
+        return optionPrice(option->volatility, data->getCommonFactor(), option->contract);
     }
 };
 
-int main() {
+SPEEDFP_DESIGN(static_cast_pricer) {
     StaticPricer pricer;
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>());
-        dataSamples.emplace_back(std::make_unique<OptionData>());
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+        }
     }
     
     benchmark("Design: Static cast with Pricer", [&]() {
         for (const auto& data : dataSamples) {
-            pricer.calculatePrice(data.get());
+            doNotOptimize(pricer.calculatePrice(data.get()));
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Static cast with Pricer", dataSamples, [&](const auto& data) {
+        return pricer.calculatePrice(data.get());
+    });
+}
+
+} // namespace
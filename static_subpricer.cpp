@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class StockPricer;
 class OptionPricer;
@@ -12,7 +15,7 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData(StockPricer* p) : Data(), pricer(p), priceFactor(1.2) {}
     double calculatePrice() const override;
@@ -20,12 +23,13 @@ public:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData(OptionPricer* p) : Data(), pricer(p), volatility(0.8) {}
+    OptionData(OptionPricer* p, const OptionContract& terms) : Data(), pricer(p), volatility(0.8), contract(terms) {}
     double calculatePrice() const override;
     OptionPricer* pricer;
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 class Pricer {
@@ -33,7 +37,7 @@ public:
     virtual double calculatePrice(const Data* data) const = 0;
 };
 
-class StockPricer : public Pricer {
+class StockPricer SPEEDFP_FINAL : public Pricer {
 public:
     double calculatePrice(const Data* data) const override { 
         auto* stock = static_cast<const StockData*>(data);
@@ -41,32 +45,40 @@ public:
     }
 };
 
-class OptionPricer : public Pricer {
+class OptionPricer SPEEDFP_FINAL : public Pricer {
 public:
     double calculatePrice(const Data* data) const override { 
         auto* option = static_cast<const OptionData*>(data);
-        return option->volatility * 2.5 + option->getCommonFactor();
+        return optionPrice(option->volatility, option->getCommonFactor(), option->contract);
     }
 };
 
 double StockData::calculatePrice() const { return pricer->calculatePrice(this); }
 double OptionData::calculatePrice() const { return pricer->calculatePrice(this); }
 
-int main() {
+SPEEDFP_DESIGN(static_subpricer) {
     StockPricer stockPricer;
     OptionPricer optionPricer;
     
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>(&stockPricer));
-        dataSamples.emplace_back(std::make_unique<OptionData>(&optionPricer));
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&stockPricer));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(&optionPricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Static cast in subpricer", [&]() {
         for (const auto& data : dataSamples) {
-            data->calculatePrice();
+            doNotOptimize(data->calculatePrice());
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Static cast in subpricer", dataSamples, [](const auto& data) {
+        return data->calculatePrice();
+    });
+}
+
+} // namespace
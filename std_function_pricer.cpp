@@ -0,0 +1,58 @@
+#include <functional>
+
+#include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
+
+struct StockData {
+    double priceFactor = 1.2;
+    double commonFactor = 0.5;
+};
+
+struct OptionData {
+    double volatility = 0.8;
+    double commonFactor = 0.5;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class Pricer {
+public:
+    double calculatePrice(const StockData& data) const { return data.priceFactor * 1.1 + data.commonFactor; }
+    double calculatePrice(const OptionData& data) const { return optionPrice(data.volatility, data.commonFactor, data.contract); }
+};
+
+// Each instrument is a std::function that captures its data by value. At 16 bytes the capture fits
+// the small-object buffer of the common standard libraries, so the book makes no extra allocations
+// (in the default option model; Black-Scholes contracts make options too big for it).
+using Data = std::function<double(const Pricer&)>;
+
+template <typename T>
+Data erase(T data) {
+    return [data](const Pricer& pricer) { return pricer.calculatePrice(data); };
+}
+
+SPEEDFP_DESIGN(std_function_pricer) {
+    Pricer pricer;
+    std::vector<Data> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.push_back(erase(StockData{}));
+        } else {
+            dataSamples.push_back(erase(OptionData{.contract = optionContract(options++)}));
+        }
+    }
+
+    benchmark("Design: std::function with Pricer", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(data(pricer));
+        }
+    }, ITERATIONS);
+
+    benchmarkScaling("Design: std::function with Pricer", dataSamples, [&](const auto& data) {
+        return data(pricer);
+    });
+}
+
+} // namespace
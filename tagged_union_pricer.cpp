@@ -0,0 +1,72 @@
+#include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
+
+// Every instrument is one 24-byte value: a type tag, the shared field and a union of the per-type
+// fields. The book is a plain array with no pointers, and the pricer switches on the tag.
+struct StockData {
+    double priceFactor = 1.2;
+};
+
+struct OptionData {
+    double volatility = 0.8;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
+};
+
+class Data {
+public:
+    explicit Data(StockData s) : tag(InstrumentKind::Stock), stock(s) {}
+    explicit Data(OptionData o) : tag(InstrumentKind::Option), option(o) {}
+
+    InstrumentKind kind() const { return tag; }
+    double getCommonFactor() const { return commonFactor; }
+    const StockData& asStock() const { return stock; }
+    const OptionData& asOption() const { return option; }
+
+private:
+    InstrumentKind tag;
+    double commonFactor = 0.5;
+    union {
+        StockData stock;
+        OptionData option;
+    };
+};
+
+static_assert(sizeof(Data) == 16 + sizeof(OptionData), "tagged union should stay packed");
+
+class SwitchPricer {
+public:
+    double calculatePrice(const Data& data) const {
+        switch (data.kind()) {
+        case InstrumentKind::Stock: return data.asStock().priceFactor * 1.1 + data.getCommonFactor();
+        case InstrumentKind::Option: return optionPrice(data.asOption().volatility, data.getCommonFactor(), data.asOption().contract);
+        }
+        return 0;
+    }
+};
+
+SPEEDFP_DESIGN(tagged_union_pricer) {
+    SwitchPricer pricer;
+    std::vector<Data> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(StockData{});
+        } else {
+            dataSamples.emplace_back(OptionData{.contract = optionContract(options++)});
+        }
+    }
+
+    benchmark("Design: Tagged union with switch Pricer", [&]() {
+        for (const auto& data : dataSamples) {
+            doNotOptimize(pricer.calculatePrice(data));
+        }
+    }, ITERATIONS);
+
+    benchmarkScaling("Design: Tagged union with switch Pricer", dataSamples, [&](const auto& data) {
+        return pricer.calculatePrice(data);
+    });
+}
+
+} // namespace
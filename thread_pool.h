@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Fixed-size pool of (optionally pinned) workers running index-based jobs. Each parallelFor splits
+// its indices into one contiguous run per worker; a worker that drains its own queue steals from
+// the back of the others, so uneven chunks still balance.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threads, bool pin = true) : queues(threads) {
+        for (size_t id = 0; id < threads; ++id) {
+            queues[id] = std::make_unique<Queue>();
+        }
+        for (size_t id = 0; id < threads; ++id) {
+            workers.emplace_back([this, id] { workerLoop(id); });
+            if (pin) pinToCore(workers.back(), id);
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    // Runs task(index) for every index in [0, count) and returns once all of them have finished.
+    void parallelFor(size_t count, std::function<void(size_t)> job) {
+        if (count == 0) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        task = std::move(job);
+        remaining.store(count);
+        size_t threads = queues.size();
+        for (size_t id = 0; id < threads; ++id) {
+            std::lock_guard<std::mutex> queueLock(queues[id]->mutex);
+            for (size_t index = id * count / threads; index < (id + 1) * count / threads; ++index) {
+                queues[id]->items.push_back(index);
+            }
+        }
+        ++generation;
+        wake.notify_all();
+        done.wait(lock, [this] { return remaining.load() == 0; });
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<size_t> items;
+    };
+
+    static void pinToCore(std::thread& thread, size_t id) {
+#ifdef __linux__
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(id % cores, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+        static_cast<void>(thread);
+        static_cast<void>(id);
+#endif
+    }
+
+    bool popOrSteal(size_t id, size_t& index) {
+        for (size_t offset = 0; offset < queues.size(); ++offset) {
+            Queue& queue = *queues[(id + offset) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.items.empty()) continue;
+            if (offset == 0) {
+                index = queue.items.front();
+                queue.items.pop_front();
+            } else {
+                index = queue.items.back();
+                queue.items.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(size_t id) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            size_t index;
+            while (popOrSteal(id, index)) {
+                task(index);
+                if (remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.notify_all();
+                }
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::function<void(size_t)> task;
+    std::atomic<size_t> remaining{0};
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.h"
+
+// In-process market tick ingestion: a tick source (a binary tick file or the synthetic generator)
+// is replayed by a producer thread at a fixed input rate into an SpscRing, and a pricing stage on
+// the consuming thread applies each tick to its instrument and reprices it.
+//
+// Latency is measured open loop: each tick is stamped with the time it was scheduled to arrive, not
+// the time the producer got round to pushing it, so a stalled consumer shows up as queueing delay
+// in every tick behind it instead of silently slowing the input down.
+
+enum class TickField : uint32_t { Factor, CommonFactor };  // priceFactor or volatility, commonFactor
+
+struct TickRecord {
+    uint32_t instrument;
+    TickField field;
+    double value;
+};
+
+// Tick files: a TickFileHeader followed by `count` packed TickRecords, little-endian.
+constexpr char TICK_FILE_MAGIC[8] = {'S', 'P', 'E', 'E', 'D', 'F', 'P', 'T'};
+constexpr uint32_t TICK_FILE_VERSION = 1;
+
+struct TickFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t count;
+};
+
+static_assert(sizeof(TickRecord) == 16 && sizeof(TickFileHeader) == 24, "tick file layout changed");
+
+inline bool writeTickFile(const std::string& path, const std::vector<TickRecord>& ticks) {
+    TickFileHeader header{};
+    std::memcpy(header.magic, TICK_FILE_MAGIC, sizeof(header.magic));
+    header.version = TICK_FILE_VERSION;
+    header.recordSize = sizeof(TickRecord);
+    header.count = ticks.size();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(ticks.data()),
+              static_cast<std::streamsize>(ticks.size() * sizeof(TickRecord)));
+    return static_cast<bool>(out);
+}
+
+// Ticks naming instruments at or beyond `instruments` are rejected, so a file recorded for a
+// larger book cannot index past the one being priced.
+inline bool loadTickFile(const std::string& path, size_t instruments, std::vector<TickRecord>& ticks) {
+    std::ifstream in(path, std::ios::binary);
+    TickFileHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) return false;
+    if (std::memcmp(header.magic, TICK_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TICK_FILE_VERSION || header.recordSize != sizeof(TickRecord)) {
+        return false;
+    }
+    // Size the vector from what the file actually holds, not from a count it may lie about.
+    in.seekg(0, std::ios::end);
+    std::streamoff end = in.tellg();
+    if (end < static_cast<std::streamoff>(sizeof(header))) return false;
+    uint64_t remaining = static_cast<uint64_t>(end) - sizeof(header);
+    if (header.count > remaining / sizeof(TickRecord)) return false;
+    in.seekg(sizeof(header));
+    ticks.resize(header.count);
+    if (!in.read(reinterpret_cast<char*>(ticks.data()),
+                 static_cast<std::streamsize>(ticks.size() * sizeof(TickRecord)))) {
+        return false;
+    }
+    for (const TickRecord& tick : ticks) {
+        if (tick.instrument >= instruments || tick.field > TickField::CommonFactor) return false;
+    }
+    return true;
+}
+
+// Random walk ticks over a book of `instruments`: uniformly chosen instruments, one tick in
+// COMMON_TICK_SHARE moving the commonFactor and the rest the instrument's own factor.
+inline std::vector<TickRecord> syntheticTicks(size_t count, size_t instruments, uint64_t seed) {
+    constexpr double COMMON_TICK_SHARE = 0.25;
+    std::mt19937_64 rng(seed);
+    auto uniform = [&]() { return static_cast<double>(rng() >> 11) * 0x1.0p-53; };
+    std::vector<TickRecord> ticks(count);
+    double level = 1.0;
+    for (TickRecord& tick : ticks) {
+        tick.instrument = static_cast<uint32_t>(rng() % instruments);
+        tick.field = uniform() < COMMON_TICK_SHARE ? TickField::CommonFactor : TickField::Factor;
+        level *= 1.0 + 1e-4 * (uniform() - 0.5);
+        tick.value = (tick.field == TickField::CommonFactor ? 0.5 : 1.0) * level;
+    }
+    return ticks;
+}
+
+struct TickRun {
+    std::vector<double> latencies;  // ns from scheduled arrival to price, per tick in input order
+    double checksum = 0;            // sum of the prices produced, to keep the stage observable
+    double seconds = 0;             // wall time of the whole replay
+};
+
+// Replays ticks at ratePerSecond (0: as fast as the ring accepts them) through a ring of
+// ringCapacity into stage, a callable double(const TickRecord&) that applies the tick and returns
+// the instrument's new price. The stage runs on the calling thread.
+template <typename Stage>
+TickRun runTickPipeline(const std::vector<TickRecord>& ticks, double ratePerSecond, size_t ringCapacity,
+                        Stage& stage) {
+    using Clock = std::chrono::steady_clock;
+    struct Event {
+        TickRecord tick;
+        Clock::time_point scheduled;
+    };
+
+    SpscRing<Event> ring(ringCapacity);
+    TickRun run;
+    run.latencies.resize(ticks.size());
+    const auto start = Clock::now();
+    const double period = ratePerSecond > 0 ? 1e9 / ratePerSecond : 0;
+
+    // Waiting sides yield rather than spin, so both ends make progress when they share a core.
+    std::thread producer([&] {
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            Event event{ticks[i], start + std::chrono::nanoseconds(static_cast<int64_t>(period * i))};
+            if (period > 0) {
+                while (Clock::now() < event.scheduled) std::this_thread::yield();
+            } else {
+                event.scheduled = Clock::now();
+            }
+            while (!ring.tryPush(event)) std::this_thread::yield();
+        }
+    });
+
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        Event event;
+        while (!ring.tryPop(event)) std::this_thread::yield();
+        run.checksum += stage(event.tick);
+        run.latencies[i] = std::chrono::duration<double, std::nano>(Clock::now() - event.scheduled).count();
+    }
+    run.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    producer.join();
+    return run;
+}
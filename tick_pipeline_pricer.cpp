@@ -0,0 +1,48 @@
+#include "benchmark.h"
+#include "instrument_books.h"
+#include "latency_report.h"
+#include "tick_pipeline.h"
+
+namespace {
+
+constexpr size_t TICK_COUNT = 100'000;
+constexpr size_t TICK_RING_CAPACITY = 4096;
+
+// Pricing stages: each design keeps its own book (instrument_books.h) and turns a tick into one
+// repriced instrument.
+
+template <typename Stage>
+void replay(const std::string& design, const std::vector<TickRecord>& ticks, Stage& stage) {
+    for (size_t rate : benchmarkOptions().tickRates) {
+        TickRun run = runTickPipeline(ticks, static_cast<double>(rate), TICK_RING_CAPACITY, stage);
+        reportLatencyRun("Tick pipeline: " + design + ", " + rateName(rate, "ticks/s", "unthrottled"), run,
+                         "tick-to-price", "ticks/s achieved");
+    }
+}
+
+SPEEDFP_DESIGN(tick_pipeline_pricer) {
+    auto kinds = workloadTypes();
+    std::vector<TickRecord> ticks;
+    const std::string& file = benchmarkOptions().tickFile;
+    if (file.empty()) {
+        ticks = syntheticTicks(TICK_COUNT, kinds.size(), benchmarkOptions().seed);
+    } else if (!loadTickFile(file, kinds.size(), ticks) || ticks.empty()) {
+        std::cerr << "    cannot replay " << file << ": unreadable, empty, or naming instruments beyond the book\n";
+        return;
+    }
+
+    books::VirtualBook virtualStage(kinds);
+    replay("virtual Data", ticks, virtualStage);
+    books::PluginBook pluginStage(kinds);
+    replay("Data with plug-in Pricer", ticks, pluginStage);
+    books::DynamicCastBook dynamicCastStage(kinds);
+    replay("dynamic_cast", ticks, dynamicCastStage);
+    books::VariantBook variantStage(kinds);
+    replay("std::variant", ticks, variantStage);
+    books::CrtpBook crtpStage(kinds);
+    replay("CRTP", ticks, crtpStage);
+    books::SoaBook soaStage(kinds);
+    replay("SoA book", ticks, soaStage);
+}
+
+} // namespace
@@ -0,0 +1,169 @@
+#include <utility>
+#include <variant>
+
+#include "benchmark.h"
+
+// Dispatch cost as the number of instrument types grows. Types 0..N-1 are stamped out from
+// templates, each with its own pricing formula so the compiler cannot merge them, and every
+// dispatch pattern prices the same book at N = 2, 4, ... 64.
+//
+// Compiling with -DSPEEDFP_TYPE_COUNT=N instantiates a single N; measure_type_scaling.sh uses that
+// to report compile time and object code size per N.
+
+namespace {
+
+// Type scaling runs 24 benchmarks per mix, and the dynamic_cast chain is linear in N.
+constexpr size_t TYPE_SCALING_ITERATIONS = ITERATIONS / 10;
+
+// A distinct formula per type: the scale differs and the number of adjustment steps cycles 0..3.
+template <size_t I>
+double syntheticPrice(double factor, double common) {
+    constexpr double scale = 1.0 + 0.01 * I;
+    double price = factor * scale + common;
+    for (size_t step = 0; step < I % 4; ++step) price = price * 0.5 + common * scale;
+    return price;
+}
+
+class Data {
+public:
+    Data(double f, double c) : factor(f), commonFactor(c) {}
+    virtual ~Data() = default;
+    virtual double calculatePrice() const = 0;
+protected:
+    double factor;
+    double commonFactor;
+};
+
+template <size_t I>
+class SyntheticData final : public Data {
+public:
+    using Data::Data;
+    double calculatePrice() const override { return price(); }
+    double price() const { return syntheticPrice<I>(factor, commonFactor); }
+};
+
+template <size_t I>
+struct SyntheticValue {
+    double factor;
+    double commonFactor;
+    double calculatePrice() const { return syntheticPrice<I>(factor, commonFactor); }
+};
+
+struct TaggedData {
+    uint32_t tag;
+    double factor;
+    double commonFactor;
+};
+
+// One case per possible type; cases at or beyond N fall to the default and are dropped from the
+// jump table, so the switch has exactly N live cases.
+#define SPEEDFP_TYPE_CASE(k)                                                                \
+    case (k):                                                                               \
+        if constexpr ((k) < N) return syntheticPrice<(k)>(data.factor, data.commonFactor); \
+        break;
+#define SPEEDFP_TYPE_CASES8(b)                                                              \
+    SPEEDFP_TYPE_CASE(b + 0) SPEEDFP_TYPE_CASE(b + 1) SPEEDFP_TYPE_CASE(b + 2)              \
+    SPEEDFP_TYPE_CASE(b + 3) SPEEDFP_TYPE_CASE(b + 4) SPEEDFP_TYPE_CASE(b + 5)              \
+    SPEEDFP_TYPE_CASE(b + 6) SPEEDFP_TYPE_CASE(b + 7)
+
+constexpr size_t MAX_SWITCH_TYPES = 64;
+
+template <size_t N, typename Tagged>
+double switchPrice(const Tagged& data) {
+    static_assert(N <= MAX_SWITCH_TYPES, "add cases to switchPrice");
+    switch (data.tag) {
+        SPEEDFP_TYPE_CASES8(0) SPEEDFP_TYPE_CASES8(8) SPEEDFP_TYPE_CASES8(16) SPEEDFP_TYPE_CASES8(24)
+        SPEEDFP_TYPE_CASES8(32) SPEEDFP_TYPE_CASES8(40) SPEEDFP_TYPE_CASES8(48) SPEEDFP_TYPE_CASES8(56)
+    default:
+        break;
+    }
+    return 0;
+}
+
+#undef SPEEDFP_TYPE_CASES8
+#undef SPEEDFP_TYPE_CASE
+
+template <size_t N, typename = std::make_index_sequence<N>>
+struct TypeSet;
+
+template <size_t N, size_t... Is>
+struct TypeSet<N, std::index_sequence<Is...>> {
+    using Variant = std::variant<SyntheticValue<Is>...>;
+
+    static InstrumentPtr<Data> makeObject(uint32_t type, double factor, double common) {
+        InstrumentPtr<Data> object;
+        ((type == Is ? (void)(object = makeInstrument<SyntheticData<Is>>(factor, common)) : (void)0), ...);
+        return object;
+    }
+
+    static Variant makeValue(uint32_t type, double factor, double common) {
+        Variant value;
+        ((type == Is ? (void)value.template emplace<Is>(SyntheticValue<Is>{factor, common}) : (void)0), ...);
+        return value;
+    }
+
+    // Tries each type in declaration order, like an if/else chain of dynamic_casts.
+    static double castPrice(const Data* data) {
+        double price = 0;
+        (void)((castTo<Is>(data, price)) || ...);
+        return price;
+    }
+
+private:
+    template <size_t I>
+    static bool castTo(const Data* data, double& price) {
+        auto* typed = dynamic_cast<const SyntheticData<I>*>(data);
+        if (typed) price = typed->price();
+        return typed != nullptr;
+    }
+};
+
+template <size_t N>
+void runTypeScaling() {
+    using Types = TypeSet<N>;
+    const auto& options = benchmarkOptions();
+    auto types = makeTypeIndexSequence(benchmarkContext().mix, bookSize(), N, options.seed, options.replay);
+
+    std::vector<InstrumentPtr<Data>> objects;
+    std::vector<typename Types::Variant> values;
+    std::vector<TaggedData> tagged;
+    for (uint32_t type : types) {
+        objects.emplace_back(Types::makeObject(type, 1.2, 0.5));
+        values.push_back(Types::makeValue(type, 1.2, 0.5));
+        tagged.push_back({type, 1.2, 0.5});
+    }
+
+    std::string suffix = ", " + std::to_string(N) + " types";
+    benchmark("Type scaling: virtual Data" + suffix, [&]() {
+        for (const auto& data : objects) doNotOptimize(data->calculatePrice());
+    }, TYPE_SCALING_ITERATIONS);
+
+    benchmark("Type scaling: std::variant + std::visit" + suffix, [&]() {
+        for (const auto& value : values) {
+            doNotOptimize(std::visit([](const auto& v) { return v.calculatePrice(); }, value));
+        }
+    }, TYPE_SCALING_ITERATIONS);
+
+    benchmark("Type scaling: dynamic_cast chain" + suffix, [&]() {
+        for (const auto& data : objects) doNotOptimize(Types::castPrice(data.get()));
+    }, TYPE_SCALING_ITERATIONS);
+
+    benchmark("Type scaling: enum-tagged switch" + suffix, [&]() {
+        for (const auto& data : tagged) doNotOptimize(switchPrice<N>(data));
+    }, TYPE_SCALING_ITERATIONS);
+}
+
+SPEEDFP_DESIGN(type_scaling_pricer) {
+#ifdef SPEEDFP_TYPE_COUNT
+    runTypeScaling<SPEEDFP_TYPE_COUNT>();
+#else
+    runTypeScaling<2>();
+    runTypeScaling<4>();
+    runTypeScaling<8>();
+    runTypeScaling<16>();
+    runTypeScaling<32>();
+    runTypeScaling<64>();
+#endif
+}
+
+} // namespace
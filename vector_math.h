@@ -0,0 +1,165 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Transcendental functions written once against a "lane" type, so the same code runs one double at
+// a time (ScalarLane) or on AVX2/AVX-512 registers (simd_lanes.h). A lane type L provides
+// WIDTH, load, store, L::splat, + - * /, sqrt, abs, min, max, round (to nearest), pow2 (2^n for an integral n),
+// frexp (mantissa in [0.5, 1) and exponent as a double) and selectLess(a, b, ifLess, otherwise).
+//
+// Error bounds, measured against libm:
+//   vexp     - relative error < 1e-15 for x in [-708, 709]; inputs outside are clamped.
+//   vlog     - absolute error < 1e-15 for x in [0.01, 100], within a few ulp of the result for
+//              other normal positive x.
+//   vnormCdf - absolute error < 7.5e-8 (Abramowitz & Stegun 26.2.17).
+//   verf     - absolute error < 1.5e-7, derived from vnormCdf.
+//   vnormInv - relative error < 1.2e-9 for p in [1e-12, 1 - 1e-12] (Acklam's approximation).
+
+constexpr double LOG2E = 1.4426950408889634;
+constexpr double LN2_HI = 0.693145751953125;  // ln 2 split for exact Cody-Waite reduction
+constexpr double LN2_LO = 1.4286068203094173e-6;
+constexpr double SQRT_HALF = 0.7071067811865476;
+constexpr double INV_SQRT_2PI = 0.3989422804014327;
+
+struct ScalarLane {
+    static constexpr size_t WIDTH = 1;
+    double v;
+
+    static ScalarLane load(const double* p) { return {*p}; }
+    void store(double* p) const { *p = v; }
+
+    static ScalarLane splat(double x) { return {x}; }
+    friend ScalarLane operator+(ScalarLane a, ScalarLane b) { return {a.v + b.v}; }
+    friend ScalarLane operator-(ScalarLane a, ScalarLane b) { return {a.v - b.v}; }
+    friend ScalarLane operator*(ScalarLane a, ScalarLane b) { return {a.v * b.v}; }
+    friend ScalarLane operator/(ScalarLane a, ScalarLane b) { return {a.v / b.v}; }
+    static ScalarLane sqrt(ScalarLane a) { return {std::sqrt(a.v)}; }
+    static ScalarLane abs(ScalarLane a) { return {std::fabs(a.v)}; }
+    static ScalarLane min(ScalarLane a, ScalarLane b) { return {a.v < b.v ? a.v : b.v}; }
+    static ScalarLane max(ScalarLane a, ScalarLane b) { return {a.v > b.v ? a.v : b.v}; }
+    static ScalarLane round(ScalarLane a) { return {std::nearbyint(a.v)}; }
+    static ScalarLane pow2(ScalarLane n) {
+        return {std::bit_cast<double>(static_cast<uint64_t>(static_cast<int64_t>(n.v) + 1023) << 52)};
+    }
+    static ScalarLane frexp(ScalarLane x, ScalarLane& exponent) {
+        uint64_t bits = std::bit_cast<uint64_t>(x.v);
+        exponent.v = static_cast<double>(static_cast<int64_t>((bits >> 52) & 0x7ff) - 1022);
+        return {std::bit_cast<double>((bits & 0x000fffffffffffffULL) | 0x3fe0000000000000ULL)};
+    }
+    static ScalarLane selectLess(ScalarLane a, ScalarLane b, ScalarLane ifLess, ScalarLane otherwise) {
+        return a.v < b.v ? ifLess : otherwise;
+    }
+};
+
+template <typename L>
+inline L vexp(L x) {
+    x = L::min(L::max(x, L::splat(-708.0)), L::splat(709.0));
+    L n = L::round(x * L::splat(LOG2E));
+    L r = x - n * L::splat(LN2_HI) - n * L::splat(LN2_LO);
+
+    // Taylor series to degree 12 on |r| <= ln2 / 2, Horner form.
+    L p = L::splat(1.0 / 479001600.0);
+    p = p * r + L::splat(1.0 / 39916800.0);
+    p = p * r + L::splat(1.0 / 3628800.0);
+    p = p * r + L::splat(1.0 / 362880.0);
+    p = p * r + L::splat(1.0 / 40320.0);
+    p = p * r + L::splat(1.0 / 5040.0);
+    p = p * r + L::splat(1.0 / 720.0);
+    p = p * r + L::splat(1.0 / 120.0);
+    p = p * r + L::splat(1.0 / 24.0);
+    p = p * r + L::splat(1.0 / 6.0);
+    p = p * r + L::splat(0.5);
+    p = p * r + L::splat(1.0);
+    p = p * r + L::splat(1.0);
+    return p * L::pow2(n);
+}
+
+template <typename L>
+inline L vlog(L x) {
+    L exponent;
+    L m = L::frexp(x, exponent);
+
+    // Move the mantissa into [sqrt(1/2), sqrt(2)) so s = (m - 1) / (m + 1) stays below 0.172.
+    L shift = L::selectLess(m, L::splat(SQRT_HALF), L::splat(1.0), L::splat(0.0));
+    m = m + m * shift;
+    exponent = exponent - shift;
+
+    L s = (m - L::splat(1.0)) / (m + L::splat(1.0));
+    L z = s * s;
+    // log(m) = 2 * atanh(s) = 2s (1 + z/3 + z^2/5 + ... + z^8/17)
+    L p = L::splat(1.0 / 17.0);
+    p = p * z + L::splat(1.0 / 15.0);
+    p = p * z + L::splat(1.0 / 13.0);
+    p = p * z + L::splat(1.0 / 11.0);
+    p = p * z + L::splat(1.0 / 9.0);
+    p = p * z + L::splat(1.0 / 7.0);
+    p = p * z + L::splat(1.0 / 5.0);
+    p = p * z + L::splat(1.0 / 3.0);
+    p = p * z + L::splat(1.0);
+    return L::splat(2.0) * s * p + exponent * L::splat(LN2_HI) + exponent * L::splat(LN2_LO);
+}
+
+// Standard normal cumulative distribution function.
+template <typename L>
+inline L vnormCdf(L x) {
+    L ax = L::abs(x);
+    L t = L::splat(1.0) / (L::splat(1.0) + L::splat(0.2316419) * ax);
+    L poly = L::splat(1.330274429);
+    poly = poly * t + L::splat(-1.821255978);
+    poly = poly * t + L::splat(1.781477937);
+    poly = poly * t + L::splat(-0.356563782);
+    poly = poly * t + L::splat(0.319381530);
+    poly = poly * t;
+    L pdf = vexp(L::splat(-0.5) * ax * ax) * L::splat(INV_SQRT_2PI);
+    L upper = L::splat(1.0) - pdf * poly;  // N(|x|)
+    return L::selectLess(x, L::splat(0.0), L::splat(1.0) - upper, upper);
+}
+
+// erf(x) = 2 N(x sqrt 2) - 1
+template <typename L>
+inline L verf(L x) {
+    return L::splat(2.0) * vnormCdf(x * L::splat(1.4142135623730951)) - L::splat(1.0);
+}
+
+// Inverse standard normal CDF for p in (0, 1). Acklam's rational approximations for the central
+// region and the tails; both are evaluated and blended so vector lanes never branch.
+template <typename L>
+inline L vnormInv(L p) {
+    constexpr double TAIL = 0.02425;
+    L q = p - L::splat(0.5);
+    L r = q * q;
+    L num = L::splat(-3.969683028665376e+01);
+    num = num * r + L::splat(2.209460984245205e+02);
+    num = num * r + L::splat(-2.759285104469687e+02);
+    num = num * r + L::splat(1.383577518672690e+02);
+    num = num * r + L::splat(-3.066479806614716e+01);
+    num = num * r + L::splat(2.506628277459239e+00);
+    L den = L::splat(-5.447609879822406e+01);
+    den = den * r + L::splat(1.615858368580409e+02);
+    den = den * r + L::splat(-1.556989798598866e+02);
+    den = den * r + L::splat(6.680131188771972e+01);
+    den = den * r + L::splat(-1.328068155288572e+01);
+    den = den * r + L::splat(1.0);
+    L central = num * q / den;
+
+    // Lower-tail formula on min(p, 1 - p), mirrored for the upper tail.
+    L t = L::sqrt(L::splat(-2.0) * vlog(L::min(p, L::splat(1.0) - p)));
+    L tailNum = L::splat(-7.784894002430293e-03);
+    tailNum = tailNum * t + L::splat(-3.223964580411365e-01);
+    tailNum = tailNum * t + L::splat(-2.400758277161838e+00);
+    tailNum = tailNum * t + L::splat(-2.549732539343734e+00);
+    tailNum = tailNum * t + L::splat(4.374664141464968e+00);
+    tailNum = tailNum * t + L::splat(2.938163982698783e+00);
+    L tailDen = L::splat(7.784695709041462e-03);
+    tailDen = tailDen * t + L::splat(3.224671290700398e-01);
+    tailDen = tailDen * t + L::splat(2.445134137142996e+00);
+    tailDen = tailDen * t + L::splat(3.754408661907416e+00);
+    tailDen = tailDen * t + L::splat(1.0);
+    L lower = tailNum / tailDen;
+    L tail = L::selectLess(q, L::splat(0.0), lower, L::splat(0.0) - lower);
+
+    return L::selectLess(L::abs(q), L::splat(0.5 - TAIL), central, tail);
+}
@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class Data {
 public:
@@ -9,7 +12,7 @@ protected:
     double commonFactor = 0.5;
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData() : priceFactor(1.2) {}
     double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
@@ -17,26 +20,35 @@ private:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData() : volatility(0.8) {}
-    double calculatePrice() const override { return volatility * 2.5 + getCommonFactor(); }
+    explicit OptionData(const OptionContract& terms) : volatility(0.8), contract(terms) {}
+    double calculatePrice() const override { return optionPrice(volatility, getCommonFactor(), contract); }
 private:
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
-int main() {
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>());
-        dataSamples.emplace_back(std::make_unique<OptionData>());
+SPEEDFP_DESIGN(virtual_function) {
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>());
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(optionContract(options++)));
+        }
     }
     
     benchmark("Design: Virtual function", [&]() {
         for (const auto& data : dataSamples) {
-            data->calculatePrice();
+            doNotOptimize(data->calculatePrice());
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Virtual function", dataSamples, [](const auto& data) {
+        return data->calculatePrice();
+    });
+}
+
+} // namespace
@@ -1,4 +1,7 @@
 #include "benchmark.h"
+#include "parallel_engine.h"
+
+namespace {
 
 class Pricer;  // Forward declaration
 
@@ -19,7 +22,7 @@ public:
     double calculatePrice(const Data* data) const { return data->calculatePrice(); }
 };
 
-class StockData : public Data {
+class StockData SPEEDFP_FINAL : public Data {
 public:
     StockData(Pricer* p) : Data(p), priceFactor(1.2) {}
     double calculatePrice() const override { return priceFactor * 1.1 + getCommonFactor(); }
@@ -27,30 +30,39 @@ private:
     double priceFactor;
 };
 
-class OptionData : public Data {
+class OptionData SPEEDFP_FINAL : public Data {
 public:
-    OptionData(Pricer* p) : Data(p), volatility(0.8) {}
-    double calculatePrice() const override { return volatility * 2.5 + getCommonFactor(); }
+    OptionData(Pricer* p, const OptionContract& terms) : Data(p), volatility(0.8), contract(terms) {}
+    double calculatePrice() const override { return optionPrice(volatility, getCommonFactor(), contract); }
 private:
     double volatility;
+    SPEEDFP_NO_UNIQUE_ADDRESS OptionContract contract;
 };
 
 double Data::calculatePriceImpl() const { return pricer->calculatePrice(this); }
 
-int main() {
+SPEEDFP_DESIGN(virtual_pricer) {
     Pricer pricer;
 
-    std::vector<std::unique_ptr<Data>> dataSamples;
-    for (size_t i = 0; i < SAMPLE_SIZE/2; ++i) {
-        dataSamples.emplace_back(std::make_unique<StockData>(&pricer));
-        dataSamples.emplace_back(std::make_unique<OptionData>(&pricer));
+    std::vector<InstrumentPtr<Data>> dataSamples;
+    size_t options = 0;
+    for (auto kind : workloadTypes()) {
+        if (kind == InstrumentKind::Stock) {
+            dataSamples.emplace_back(makeInstrument<StockData>(&pricer));
+        } else {
+            dataSamples.emplace_back(makeInstrument<OptionData>(&pricer, optionContract(options++)));
+        }
     }
     
     benchmark("Design: Virtual Function with Pricer", [&]() {
         for (const auto& data : dataSamples) {
-            data->calculatePriceImpl();
+            doNotOptimize(data->calculatePriceImpl());
         }
     }, ITERATIONS);
 
-    return 0;
-} 
\ No newline at end of file
+    benchmarkScaling("Design: Virtual Function with Pricer", dataSamples, [](const auto& data) {
+        return data->calculatePriceImpl();
+    });
+}
+
+} // namespace
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Type sequences used to fill every design's book. The original strictly alternating pattern is
+// learned perfectly by branch and indirect-target predictors, so the other mixes show how each
+// dispatch strategy degrades once the type order stops being predictable. All mixes are
+// reproducible from the seed; the shuffle avoids std::shuffle so sequences match across standard libraries.
+
+enum class InstrumentKind : uint8_t { Stock, Option };
+
+enum class TypeMix { Alternating, Shuffled, Skewed, Bursty, Replay };
+
+constexpr uint64_t DEFAULT_WORKLOAD_SEED = 42;
+constexpr double SKEWED_STOCK_SHARE = 0.95;
+constexpr size_t MEAN_BURST_LENGTH = 64;
+
+inline const char* typeMixName(TypeMix mix) {
+    switch (mix) {
+    case TypeMix::Shuffled: return "shuffled";
+    case TypeMix::Skewed: return "skewed";
+    case TypeMix::Bursty: return "bursty";
+    case TypeMix::Replay: return "replay";
+    default: return "alternating";
+    }
+}
+
+inline bool parseTypeMix(const std::string& name, TypeMix& mix) {
+    for (TypeMix candidate : {TypeMix::Alternating, TypeMix::Shuffled, TypeMix::Skewed, TypeMix::Bursty, TypeMix::Replay}) {
+        if (name == typeMixName(candidate)) {
+            mix = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Instrument counts on the command line: "250000", "64K" or "10M"; 0 when malformed.
+inline size_t parseSize(const std::string& text) {
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text.c_str(), &end, 10);
+    std::string suffix = end;
+    if (suffix == "K" || suffix == "k") value *= 1'000;
+    else if (suffix == "M" || suffix == "m") value *= 1'000'000;
+    else if (!suffix.empty()) return 0;
+    return static_cast<size_t>(value);
+}
+
+// Replay files list instrument types as characters: 'S' for a stock, 'O' for an option. Anything
+// else (whitespace, newlines, comments without those letters) is ignored.
+inline bool loadTypeSequence(const std::string& path, std::vector<InstrumentKind>& sequence) {
+    std::ifstream in(path);
+    if (!in) return false;
+    sequence.clear();
+    for (char c; in.get(c);) {
+        if (c == 'S') sequence.push_back(InstrumentKind::Stock);
+        if (c == 'O') sequence.push_back(InstrumentKind::Option);
+    }
+    return !sequence.empty();
+}
+
+// Fisher-Yates on raw mt19937_64 output; std::shuffle's draws differ between standard libraries.
+template <typename T>
+void shuffleSequence(std::vector<T>& sequence, std::mt19937_64& rng) {
+    for (size_t i = sequence.size(); i > 1; --i) {
+        std::swap(sequence[i - 1], sequence[rng() % i]);
+    }
+}
+
+// `replay` is cycled to length n for TypeMix::Replay and ignored otherwise.
+inline std::vector<InstrumentKind> makeTypeSequence(TypeMix mix, size_t n, uint64_t seed,
+                                                    const std::vector<InstrumentKind>& replay = {}) {
+    std::vector<InstrumentKind> sequence(n);
+    std::mt19937_64 rng(seed);
+    auto uniform = [&]() { return static_cast<double>(rng() >> 11) * 0x1.0p-53; };
+
+    switch (mix) {
+    case TypeMix::Alternating:
+        for (size_t i = 0; i < n; ++i) {
+            sequence[i] = i % 2 == 0 ? InstrumentKind::Stock : InstrumentKind::Option;
+        }
+        break;
+    case TypeMix::Shuffled:
+        for (size_t i = 0; i < n; ++i) {
+            sequence[i] = i < n / 2 ? InstrumentKind::Stock : InstrumentKind::Option;
+        }
+        shuffleSequence(sequence, rng);
+        break;
+    case TypeMix::Skewed:
+        for (size_t i = 0; i < n; ++i) {
+            sequence[i] = uniform() < SKEWED_STOCK_SHARE ? InstrumentKind::Stock : InstrumentKind::Option;
+        }
+        break;
+    case TypeMix::Bursty: {
+        // Runs of one type with lengths uniform in [1, 2 * MEAN_BURST_LENGTH - 1].
+        InstrumentKind kind = InstrumentKind::Stock;
+        for (size_t i = 0; i < n;) {
+            size_t length = 1 + rng() % (2 * MEAN_BURST_LENGTH - 1);
+            for (size_t j = 0; j < length && i < n; ++j) sequence[i++] = kind;
+            kind = kind == InstrumentKind::Stock ? InstrumentKind::Option : InstrumentKind::Stock;
+        }
+        break;
+    }
+    case TypeMix::Replay:
+        for (size_t i = 0; i < n; ++i) {
+            sequence[i] = replay.empty() ? InstrumentKind::Stock : replay[i % replay.size()];
+        }
+        break;
+    }
+    return sequence;
+}
+
+// The same mixes over `types` >= 2 instrument types numbered 0..types-1: alternating cycles through
+// them, shuffled balances them in random order, skewed gives type 0 SKEWED_STOCK_SHARE of the book
+// and the others the rest evenly, bursty switches to a random other type after every run, and
+// replay maps stocks to 0 and options to 1.
+inline std::vector<uint32_t> makeTypeIndexSequence(TypeMix mix, size_t n, size_t types, uint64_t seed,
+                                                   const std::vector<InstrumentKind>& replay = {}) {
+    std::vector<uint32_t> sequence(n);
+    std::mt19937_64 rng(seed);
+    auto uniform = [&]() { return static_cast<double>(rng() >> 11) * 0x1.0p-53; };
+    auto otherType = [&](uint32_t type) {
+        return static_cast<uint32_t>((type + 1 + rng() % (types - 1)) % types);
+    };
+
+    switch (mix) {
+    case TypeMix::Alternating:
+        for (size_t i = 0; i < n; ++i) sequence[i] = static_cast<uint32_t>(i % types);
+        break;
+    case TypeMix::Shuffled:
+        for (size_t i = 0; i < n; ++i) sequence[i] = static_cast<uint32_t>(i * types / n);
+        shuffleSequence(sequence, rng);
+        break;
+    case TypeMix::Skewed:
+        for (size_t i = 0; i < n; ++i) sequence[i] = uniform() < SKEWED_STOCK_SHARE ? 0 : otherType(0);
+        break;
+    case TypeMix::Bursty: {
+        uint32_t type = 0;
+        for (size_t i = 0; i < n;) {
+            size_t length = 1 + rng() % (2 * MEAN_BURST_LENGTH - 1);
+            for (size_t j = 0; j < length && i < n; ++j) sequence[i++] = type;
+            type = otherType(type);
+        }
+        break;
+    }
+    case TypeMix::Replay:
+        for (size_t i = 0; i < n; ++i) {
+            sequence[i] = replay.empty() || replay[i % replay.size()] == InstrumentKind::Stock ? 0 : 1;
+        }
+        break;
+    }
+    return sequence;
+}